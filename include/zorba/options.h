@@ -107,7 +107,8 @@ typedef enum
   ZORBA_SERIALIZATION_METHOD_TEXT,
   ZORBA_SERIALIZATION_METHOD_BINARY,
   ZORBA_SERIALIZATION_METHOD_JSON,
-  ZORBA_SERIALIZATION_METHOD_JSON_XML_HYBRID
+  ZORBA_SERIALIZATION_METHOD_JSON_XML_HYBRID,
+  ZORBA_SERIALIZATION_METHOD_BINARY_XDM
 } Zorba_serialization_method_t;
 
 typedef enum 
@@ -243,6 +244,17 @@ typedef struct ZORBA_DLL_PUBLIC Zorba_SerializerOptions
   Zorba_jsoniq_multiple_items_t jsoniq_multiple_items;
   Zorba_serialization_method_t  jsoniq_xdm_method;
 
+  /**
+   * Zorba extension: the number of worker threads that serialize the
+   * top-level items of the result concurrently ("parallel-threads"); 0 (the
+   * default) means sequential serialization, and values above 16 are
+   * rejected with err::SEPM0016. It is honored only by builds without
+   * ZORBA_FOR_ONE_THREAD_ONLY, for the json method and, provided there is
+   * no indentation, doctype, item-separator, or transcoding, for the xml,
+   * text, and json-xml-hybrid methods.
+   */
+  unsigned                      parallel_threads;
+
 #ifdef __cplusplus
   typedef std::pair<std::string,std::string> string_pair;
 
@@ -257,6 +269,7 @@ typedef struct ZORBA_DLL_PUBLIC Zorba_SerializerOptions
    *  - omit-xml-declaration: NO
    *  - standalone: omit
    *  - undeclare-prefixes: NO
+   *  - parallel-threads: 0
    */
   Zorba_SerializerOptions();
 
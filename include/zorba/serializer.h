@@ -48,6 +48,20 @@ namespace zorba {
         Iterator_t object,
         std::ostream& stream) const = 0;
 
+      /**
+       * \brief Reads back a sequence that was serialized using the
+       *        "binary-xdm" serialization method.
+       *
+       * The items are created while the returned sequence is iterated, so the
+       * stream must remain valid until then. The sequence can be iterated
+       * only once. Nodes are created untyped.
+       *
+       * @param stream the stream to read the encoded sequence from.
+       * @return the decoded sequence.
+       */
+      static ItemSequence_t
+      parseBinaryXDM(std::istream& stream);
+
   };
 
 } /* namespace zorba */
@@ -118,6 +118,76 @@ inline void encode_chunk( char const *from, char *to ) {
   to[3] = alphabet[   u[2] & 0x3F                      ];
 }
 
+/**
+ * Lookup tables for the block-at-a-time encoding and decoding loops.  They're
+ * derived from \c alphabet and \c decode_table at static-initialization time.
+ */
+struct block_tables {
+  /**
+   * The pair of Base64 characters for every 12-bit value: a 3-byte chunk is
+   * encoded by two lookups rather than four.
+   */
+  char encode_pair[ 4096 ][ 2 ];
+
+  /**
+   * The decoded value of a character already shifted into its position within
+   * the 24-bit value of a 4-character chunk.  Characters that need the slow
+   * path (invalid characters, whitespace, and '=') have \c BAD set.
+   */
+  uint32_t decode_shifted[ 4 ][ 256 ];
+
+  static uint32_t const BAD = 0x80000000u;
+
+  block_tables();
+};
+
+block_tables::block_tables() {
+  for ( unsigned n = 0; n < 4096; ++n ) {
+    encode_pair[ n ][0] = alphabet[ n >> 6   ];
+    encode_pair[ n ][1] = alphabet[ n & 0x3F ];
+  }
+  for ( unsigned c = 0; c < 256; ++c ) {
+    signed char const value = decode_table[ c ];
+    for ( unsigned i = 0; i < 4; ++i )
+      decode_shifted[ i ][ c ] = value < 0 ?
+        BAD : static_cast<uint32_t>( value ) << (18 - 6 * i);
+  }
+}
+
+static block_tables const tables;
+
+/**
+ * Decodes a 4-character chunk consisting only of Base64 alphabet characters.
+ *
+ * @param from A pointer to the 4 characters to decode.
+ * @param to A pointer to the buffer to receive the 3 decoded bytes or null if
+ * only validating.
+ * @return Returns \c false only if any of the characters isn't in the Base64
+ * alphabet (in which case nothing is written).
+ */
+inline bool decode_block( char const *from, char *to ) {
+  unsigned char const *const u = reinterpret_cast<unsigned char const*>( from );
+  uint32_t const n =  tables.decode_shifted[0][ u[0] ]
+                    | tables.decode_shifted[1][ u[1] ]
+                    | tables.decode_shifted[2][ u[2] ]
+                    | tables.decode_shifted[3][ u[3] ];
+  if ( n & block_tables::BAD )
+    return false;
+  if ( to ) {
+    to[0] = static_cast<char>( n >> 16 );
+    to[1] = static_cast<char>( n >>  8 );
+    to[2] = static_cast<char>( n       );
+  }
+  return true;
+}
+
+inline void encode_block( char const *from, char *to ) {
+  unsigned char const *const u = reinterpret_cast<unsigned char const*>( from );
+  uint32_t const n = (uint32_t)u[0] << 16 | (uint32_t)u[1] << 8 | u[2];
+  ::memcpy( to    , tables.encode_pair[ n >> 12    ], 2 );
+  ::memcpy( to + 2, tables.encode_pair[ n &  0xFFF ], 2 );
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 size_type decode( char const *from, size_type from_len, char *to,
@@ -129,6 +199,23 @@ size_type decode( char const *from, size_type from_len, char *to,
   char const *const to_orig = to;
 
   for ( size_type pos = 0; pos < from_len; ++pos, ++from ) {
+    if ( !pads && !(chunk_len % 4) ) {
+      //
+      // At a chunk boundary, decode whole chunks directly for as long as they
+      // contain only Base64 alphabet characters; anything else (whitespace,
+      // padding, or an invalid character) is handled one character at a time
+      // below.
+      //
+      while ( from_len - pos >= 4 && decode_block( from, to ) ) {
+        if ( to )
+          to += 3;
+        chunk_len = 4;
+        pos += 4, from += 4;
+      }
+      if ( pos == from_len )
+        break;
+    }
+
     char const c = *from;
     signed char value;
     if ( c == '=' ) {
@@ -283,15 +370,10 @@ size_type decode( istream &from, vector<char> *to, int options ) {
 
 size_type encode( char const *from, size_type from_len, char *to ) {
   char const *const to_orig = to;
-  int chunk_len = 0;
 
-  while ( from_len-- ) {
-    if ( ++chunk_len == 3 ) {
-      encode_chunk( from, to );
-      from += 3, to += 4;
-      chunk_len = 0;
-    }
-  }
+  for ( ; from_len >= 3; from_len -= 3, from += 3, to += 4 )
+    encode_block( from, to );
+  int const chunk_len = static_cast<int>( from_len );
 
   if ( chunk_len ) {                    // must be either 1 or 2
     //
@@ -70,6 +70,75 @@ static signed char const decode_table[] = {
   /* F8-FF */ -1, -1, -1, -1, -1, -1, -1, -1,
 };
 
+/**
+ * Lookup tables for the block-at-a-time encoding and decoding loops.  They're
+ * derived from \c decode_table at static-initialization time.
+ */
+struct block_tables {
+  /**
+   * The pair of hexadecimal digits for every byte value.
+   */
+  char encode_pair[ 256 ][ 2 ];
+
+  /**
+   * The decoded value of a digit as the high and low nibble of a byte.
+   * Invalid digits have \c BAD set.
+   */
+  unsigned short decode_high[ 256 ], decode_low[ 256 ];
+
+  static unsigned short const BAD = 0x100;
+
+  block_tables();
+};
+
+block_tables::block_tables() {
+  static char const digits[] = "0123456789ABCDEF";
+  for ( unsigned c = 0; c < 256; ++c ) {
+    encode_pair[ c ][0] = digits[ c >> 4   ];
+    encode_pair[ c ][1] = digits[ c & 0x0F ];
+    signed char const value = decode_table[ c ];
+    if ( value < 0 )
+      decode_high[ c ] = decode_low[ c ] = BAD;
+    else {
+      decode_high[ c ] = static_cast<unsigned short>( value << 4 );
+      decode_low [ c ] = static_cast<unsigned short>( value );
+    }
+  }
+}
+
+static block_tables const tables;
+
+/**
+ * The number of hexadecimal digits decoded at a time by decode_block().
+ */
+size_type const BLOCK_SIZE = 8;
+
+/**
+ * Decodes \c BLOCK_SIZE hexadecimal digits.
+ *
+ * @param from A pointer to the digits to decode.
+ * @param to A pointer to the buffer to receive the decoded bytes or null if
+ * only validating.
+ * @return Returns \c false only if any of the digits is invalid (in which
+ * case nothing is written).
+ */
+inline bool decode_block( char const *from, char *to ) {
+  unsigned char const *const u = reinterpret_cast<unsigned char const*>( from );
+  unsigned const b0 = tables.decode_high[ u[0] ] | tables.decode_low[ u[1] ];
+  unsigned const b1 = tables.decode_high[ u[2] ] | tables.decode_low[ u[3] ];
+  unsigned const b2 = tables.decode_high[ u[4] ] | tables.decode_low[ u[5] ];
+  unsigned const b3 = tables.decode_high[ u[6] ] | tables.decode_low[ u[7] ];
+  if ( (b0 | b1 | b2 | b3) & block_tables::BAD )
+    return false;
+  if ( to ) {
+    to[0] = static_cast<char>( b0 );
+    to[1] = static_cast<char>( b1 );
+    to[2] = static_cast<char>( b2 );
+    to[3] = static_cast<char>( b3 );
+  }
+  return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 size_type decode( char const *from, size_type from_len, char *to,
@@ -85,6 +154,17 @@ size_type decode( char const *from, size_type from_len, char *to,
   char const *const to_orig = to;
   char c;
 
+  //
+  // Decode whole blocks at a time; the block containing an invalid digit (if
+  // any) is redone below one digit at a time to find it.
+  //
+  while ( static_cast<size_type>( from_end - from ) >= BLOCK_SIZE &&
+          decode_block( from, to ) ) {
+    from += BLOCK_SIZE;
+    if ( to )
+      to += BLOCK_SIZE / 2;
+  }
+
   while ( from < from_end ) {
     signed char const high = decode_table[ (unsigned char)(c = *from++) ];
     if ( high == -1 )
@@ -184,14 +264,9 @@ size_type decode( istream &from, vector<char> *to, int options ) {
 ///////////////////////////////////////////////////////////////////////////////
 
 size_type encode( char const *from, size_type from_len, char *to ) {
-  static char const encode_table[] = "0123456789ABCDEF";
-
   char const *const to_orig = to;
-  while ( from_len-- ) {
-    unsigned char const c = *from++;
-    *to++ = encode_table[ c >> 4   ];
-    *to++ = encode_table[ c & 0x0F ];
-  }
+  for ( ; from_len; --from_len, to += 2 )
+    ::memcpy( to, tables.encode_pair[ (unsigned char)*from++ ], 2 );
   return to - to_orig;
 }
 
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "stdafx.h"
+
+#include <zorba/item.h>
+
+#include "api/item_seq_binary_xdm.h"
+
+#include "diagnostics/xquery_diagnostics.h"
+
+#include "store/api/item.h"
+
+namespace zorba { 
+
+
+/*******************************************************************************
+
+********************************************************************************/
+BinaryXDMItemSequence::BinaryXDMItemSequence(std::istream& aStream)
+  :
+  theStream(aStream),
+  theHasIterator(false)
+{
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+Iterator_t BinaryXDMItemSequence::getIterator()
+{
+  if (theHasIterator)
+    throw ZORBA_EXCEPTION(zerr::ZAPI0039_XQUERY_HAS_ITERATOR_ALREADY);
+
+  theHasIterator = true;
+  return new InternalIterator(theStream);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+BinaryXDMItemSequence::InternalIterator::InternalIterator(std::istream& aStream)
+  :
+  theLoader(aStream),
+  theIsOpen(false)
+{
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void BinaryXDMItemSequence::InternalIterator::open()
+{
+  if (theIsOpen)
+    throw ZORBA_EXCEPTION(zerr::ZAPI0041_ITERATOR_ALREADY_OPEN);
+
+  theIsOpen = true;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool BinaryXDMItemSequence::InternalIterator::next(Item& aItem)
+{
+  if (!theIsOpen)
+    throw ZORBA_EXCEPTION(zerr::ZAPI0040_ITERATOR_NOT_OPEN);
+
+  store::Item_t lItem;
+  if (!theLoader.next(lItem))
+    return false;
+
+  aItem = lItem.getp();
+  return true;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void BinaryXDMItemSequence::InternalIterator::close()
+{
+  if (!theIsOpen)
+    throw ZORBA_EXCEPTION(zerr::ZAPI0040_ITERATOR_NOT_OPEN);
+
+  theIsOpen = false;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool BinaryXDMItemSequence::InternalIterator::isOpen() const
+{
+  return theIsOpen;
+}
+
+} // namespace zorba
+/* vim:set et sw=2 ts=2: */
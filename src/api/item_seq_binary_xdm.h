@@ -0,0 +1,70 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#ifndef ZORBA_API_ITEM_SEQUENCE_BINARY_XDM
+#define ZORBA_API_ITEM_SEQUENCE_BINARY_XDM
+
+#include <iostream>
+
+#include <zorba/config.h>
+#include <zorba/item_sequence.h>
+#include <zorba/iterator.h>
+
+#include "api/serialization/binary_xdm.h"
+
+namespace zorba { 
+
+/*******************************************************************************
+  An ItemSequence representing a sequence in the binary-xdm encoding (see
+  Serializer::parseBinaryXDM()). The items are created while the sequence is
+  iterated, so the stream must outlive the sequence. Since the stream is read
+  only once, at most one iterator may be created.
+********************************************************************************/
+class BinaryXDMItemSequence : public ItemSequence
+{
+  class InternalIterator : public Iterator
+  {
+  private:
+    binary_xdm_loader   theLoader;
+    bool                theIsOpen;
+
+  public:
+    InternalIterator(std::istream& stream);
+
+    virtual void open();
+
+    virtual bool next(Item& aItem);
+
+    virtual void close();
+
+    virtual bool isOpen() const;
+  };
+
+ protected:
+  std::istream  & theStream;
+  bool            theHasIterator;
+
+ public:
+  BinaryXDMItemSequence(std::istream& stream);
+
+  virtual Iterator_t getIterator();
+};
+
+} // namespace zorba
+#endif
+
+
+/* vim:set et sw=2 ts=2: */
@@ -25,6 +25,7 @@
 #include "diagnostics/zorba_exception.h"
 #include "util/ascii_util.h"
 #include "util/stl_util.h"
+#include "util/string_util.h"
 #include "zorbatypes/zstring.h"
 
 using namespace std;
@@ -78,6 +79,8 @@ static void null_ptrs( Zorba_SerializerOptions_t *opts ) {
 static bool parse_method( char const *value, Zorba_serialization_method_t *m ) {
   if ( strcmp( value, "binary" ) == 0 )
     *m = ZORBA_SERIALIZATION_METHOD_BINARY;
+  else if ( strcmp( value, "binary-xdm" ) == 0 )
+    *m = ZORBA_SERIALIZATION_METHOD_BINARY_XDM;
   else if ( strcmp( value, "html" ) == 0 )
     *m = ZORBA_SERIALIZATION_METHOD_HTML;
   else if ( strcmp( value, "json" ) == 0 )
@@ -113,6 +116,7 @@ void Zorba_SerializerOptions_init( Zorba_SerializerOptions_t *opts ) {
   opts->jsoniq_xdm_method = ZORBA_SERIALIZATION_METHOD_XML;
   opts->normalization_form = ZORBA_NORMALIZATION_FORM_NONE;
   opts->omit_xml_declaration = ZORBA_OMIT_XML_DECLARATION_NO;
+  opts->parallel_threads = 0;
   opts->ser_method = ZORBA_SERIALIZATION_METHOD_JSON_XML_HYBRID;
   opts->standalone = ZORBA_STANDALONE_OMIT;
   opts->undeclare_prefixes = ZORBA_UNDECLARE_PREFIXES_NO;
@@ -191,6 +195,16 @@ Zorba_opt_bool_t Zorba_SerializerOptions_set( Zorba_SerializerOptions_t *opts,
   if ( strcmp( option, "omit-xml-declaration" ) == 0 )
     return parse_yes_no( value, &opts->omit_xml_declaration );
 
+  if ( strcmp( option, "parallel-threads" ) == 0 ) {
+    try {
+      opts->parallel_threads = ztd::aton<unsigned>( value );
+      return true;
+    }
+    catch ( std::exception const& ) {
+      return false;
+    }
+  }
+
   if ( strcmp( option, "standalone" ) == 0 ) {
     if ( parse_yes_no( value, &opts->standalone ) )
       return true;
@@ -0,0 +1,575 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "stdafx.h"
+
+#include <cstring>
+
+#include "diagnostics/xquery_diagnostics.h"
+#include "diagnostics/assert.h"
+
+#include "api/serialization/binary_xdm.h"
+
+#include "compiler/parser/query_loc.h"
+
+#include "system/globalenv.h"
+
+#include "types/casting.h"
+#include "types/root_typemanager.h"
+#include "types/typeops.h"
+
+#include "zorbatypes/float.h"
+
+#include "store/api/item.h"
+#include "store/api/item_factory.h"
+
+namespace zorba {
+
+
+/*******************************************************************************
+
+********************************************************************************/
+binary_xdm_loader::binary_xdm_loader(std::istream& is)
+  :
+  theBuffer(is.rdbuf()),
+  theStarted(false),
+  theFinished(false),
+  theDepth(0)
+{
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool binary_xdm_loader::next(store::Item_t& result)
+{
+  if (theFinished)
+    return false;
+
+  if (!theStarted)
+  {
+    read_header();
+    theStarted = true;
+  }
+
+  int tag = read_byte();
+
+  if (tag == binary_xdm::END)
+  {
+    theFinished = true;
+    return false;
+  }
+
+  theDepth = 0;
+  read_item(result, NULL, tag);
+  return true;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_header()
+{
+  char magic[sizeof(binary_xdm::MAGIC)];
+  read_bytes(magic, sizeof(magic));
+
+  if (memcmp(magic, binary_xdm::MAGIC, sizeof(magic)) != 0)
+    raise_error("not a binary-xdm stream");
+
+  if (read_byte() != binary_xdm::VERSION)
+    raise_error("unsupported binary-xdm version");
+}
+
+
+/*******************************************************************************
+  Creates the item that starts with the given tag. If parent is not NULL, the
+  item must be a node that can be a child of an element or document node, and
+  it is appended to the children of parent.
+********************************************************************************/
+void binary_xdm_loader::read_item(
+    store::Item_t& result,
+    store::Item* parent,
+    int tag)
+{
+  store::ItemFactory* factory = GENV_ITEMFACTORY;
+
+  if (theDepth == binary_xdm::MAX_DEPTH)
+    raise_error("items nested too deeply");
+
+  ++theDepth;
+
+  if (parent != NULL &&
+      tag != binary_xdm::ELEMENT &&
+      tag != binary_xdm::TEXT &&
+      tag != binary_xdm::COMMENT &&
+      tag != binary_xdm::PI)
+  {
+    raise_error("invalid child node");
+  }
+
+  switch (tag)
+  {
+  case binary_xdm::ATOMIC:
+  {
+    read_atomic(result);
+    break;
+  }
+  case binary_xdm::USER_ATOMIC:
+  {
+    store::Item_t typeName;
+    store::Item_t baseItem;
+    read_qname(typeName);
+
+    if (read_byte() != binary_xdm::ATOMIC)
+      raise_error("invalid base item");
+
+    read_atomic(baseItem);
+    factory->createUserTypedAtomicItem(result, baseItem, typeName);
+    break;
+  }
+  case binary_xdm::DOCUMENT:
+  {
+    zstring baseUri;
+    zstring docUri;
+    read_string(baseUri);
+    read_string(docUri);
+
+    factory->createDocumentNode(result, baseUri, docUri);
+    read_children(result.getp());
+    break;
+  }
+  case binary_xdm::ELEMENT:
+  {
+    store::Item_t nodeName;
+    store::Item_t typeName = GENV_TYPESYSTEM.XS_UNTYPED_QNAME;
+    store::NsBindings bindings;
+    zstring baseUri;
+
+    read_qname(nodeName);
+
+    uint64_t numBindings = read_varint();
+    for (uint64_t i = 0; i < numBindings; ++i)
+    {
+      zstring prefix;
+      zstring uri;
+      read_name(prefix);
+      read_name(uri);
+      bindings.push_back(store::NsBindings::value_type(prefix, uri));
+    }
+
+    factory->createElementNode(result, parent, nodeName, typeName,
+                               false, false, bindings, baseUri);
+
+    uint64_t numAttrs = read_varint();
+    for (uint64_t i = 0; i < numAttrs; ++i)
+    {
+      store::Item_t attrName;
+      store::Item_t attrType = GENV_TYPESYSTEM.XS_UNTYPED_ATOMIC_QNAME;
+      store::Item_t attrValue;
+      store::Item_t attr;
+      zstring value;
+
+      read_qname(attrName);
+      read_string(value);
+      factory->createUntypedAtomic(attrValue, value);
+      factory->createAttributeNode(attr, result.getp(), attrName, attrType, attrValue);
+    }
+
+    read_children(result.getp());
+    break;
+  }
+  case binary_xdm::ATTRIBUTE:
+  {
+    store::Item_t attrName;
+    store::Item_t attrType = GENV_TYPESYSTEM.XS_UNTYPED_ATOMIC_QNAME;
+    store::Item_t attrValue;
+    zstring value;
+
+    read_qname(attrName);
+    read_string(value);
+    factory->createUntypedAtomic(attrValue, value);
+    factory->createAttributeNode(result, NULL, attrName, attrType, attrValue);
+    break;
+  }
+  case binary_xdm::TEXT:
+  {
+    zstring content;
+    read_string(content);
+    factory->createTextNode(result, parent, content);
+    break;
+  }
+  case binary_xdm::COMMENT:
+  {
+    zstring content;
+    read_string(content);
+    factory->createCommentNode(result, parent, content);
+    break;
+  }
+  case binary_xdm::PI:
+  {
+    zstring target;
+    zstring content;
+    zstring baseUri;
+    read_name(target);
+    read_string(content);
+    factory->createPiNode(result, parent, target, content, baseUri);
+    break;
+  }
+  case binary_xdm::NAMESPACE:
+  {
+    zstring prefix;
+    zstring uri;
+    read_name(prefix);
+    read_name(uri);
+    factory->createNamespaceNode(result, prefix, uri);
+    break;
+  }
+  case binary_xdm::OBJECT:
+  {
+    // The counts are not used to size the vectors up front, so that a corrupt
+    // count cannot make us allocate an arbitrary amount of memory.
+    uint64_t numPairs = read_varint();
+    std::vector<store::Item_t> names;
+    std::vector<store::Item_t> values;
+
+    for (uint64_t i = 0; i < numPairs; ++i)
+    {
+      zstring name;
+      store::Item_t nameItem;
+      store::Item_t value;
+      read_name(name);
+      factory->createString(nameItem, name);
+      read_item(value, NULL, read_byte());
+      names.push_back(nameItem);
+      values.push_back(value);
+    }
+
+    factory->createJSONObject(result, names, values);
+    break;
+  }
+  case binary_xdm::ARRAY:
+  {
+    uint64_t numMembers = read_varint();
+    std::vector<store::Item_t> members;
+
+    for (uint64_t i = 0; i < numMembers; ++i)
+    {
+      store::Item_t member;
+      read_item(member, NULL, read_byte());
+      members.push_back(member);
+    }
+
+    factory->createJSONArray(result, members);
+    break;
+  }
+  default:
+  {
+    raise_error("invalid item tag");
+  }
+  }
+
+  --theDepth;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_children(store::Item* parent)
+{
+  int tag;
+  while ((tag = read_byte()) != binary_xdm::END)
+  {
+    store::Item_t child;
+    read_item(child, parent, tag);
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_atomic(store::Item_t& result)
+{
+  store::ItemFactory* factory = GENV_ITEMFACTORY;
+
+  int typeCode = read_byte();
+
+  switch (typeCode)
+  {
+  case store::XS_BOOLEAN:
+  {
+    factory->createBoolean(result, read_byte() != 0);
+    break;
+  }
+  case store::XS_DOUBLE:
+  {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i)
+      bits |= static_cast<uint64_t>(read_byte()) << (8 * i);
+
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    factory->createDouble(result, xs_double(value));
+    break;
+  }
+  case store::XS_FLOAT:
+  {
+    uint32_t bits = 0;
+    for (int i = 0; i < 4; ++i)
+      bits |= static_cast<uint32_t>(read_byte()) << (8 * i);
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    factory->createFloat(result, xs_float(value));
+    break;
+  }
+  case store::XS_LONG:
+  case store::XS_INT:
+  case store::XS_SHORT:
+  case store::XS_BYTE:
+  {
+    uint64_t zigzag = read_varint();
+    int64_t value = static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+
+    if (typeCode == store::XS_LONG)
+      factory->createLong(result, static_cast<xs_long>(value));
+    else if (typeCode == store::XS_INT)
+      factory->createInt(result, static_cast<xs_int>(value));
+    else if (typeCode == store::XS_SHORT)
+      factory->createShort(result, static_cast<xs_short>(value));
+    else
+      factory->createByte(result, static_cast<xs_byte>(value));
+    break;
+  }
+  case store::XS_UNSIGNED_LONG:
+  {
+    factory->createUnsignedLong(result, static_cast<xs_unsignedLong>(read_varint()));
+    break;
+  }
+  case store::XS_UNSIGNED_INT:
+  {
+    factory->createUnsignedInt(result, static_cast<xs_unsignedInt>(read_varint()));
+    break;
+  }
+  case store::XS_UNSIGNED_SHORT:
+  {
+    factory->createUnsignedShort(result, static_cast<xs_unsignedShort>(read_varint()));
+    break;
+  }
+  case store::XS_UNSIGNED_BYTE:
+  {
+    factory->createUnsignedByte(result, static_cast<xs_unsignedByte>(read_varint()));
+    break;
+  }
+  case store::XS_QNAME:
+  {
+    read_qname(result);
+    break;
+  }
+  case store::XS_NOTATION:
+  {
+    store::Item_t qname;
+    read_qname(qname);
+    factory->createNOTATION(result, qname);
+    break;
+  }
+  case store::JS_NULL:
+  {
+    factory->createJSONNull(result);
+    break;
+  }
+  case store::XS_STRING:
+  {
+    zstring value;
+    read_string(value);
+    factory->createString(result, value);
+    break;
+  }
+  case store::XS_UNTYPED_ATOMIC:
+  {
+    zstring value;
+    read_string(value);
+    factory->createUntypedAtomic(result, value);
+    break;
+  }
+  case store::XS_ANY_URI:
+  {
+    zstring value;
+    read_string(value);
+    factory->createAnyURI(result, value);
+    break;
+  }
+  default:
+  {
+    if (typeCode <= store::XS_ANY_ATOMIC || typeCode >= store::XS_LAST)
+      raise_error("invalid atomic type code");
+
+    zstring value;
+    read_string(value);
+
+    const TypeManager* tm = &GENV_TYPESYSTEM;
+    xqtref_t type = tm->create_builtin_atomic_type(
+        static_cast<store::SchemaTypeCode>(typeCode),
+        SequenceType::QUANT_ONE);
+
+    GenericCast::castStringToAtomic(result, value, type.getp(), tm, NULL,
+                                    QueryLoc::null);
+  }
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+unsigned char binary_xdm_loader::read_byte()
+{
+  std::streambuf::int_type c = theBuffer->sbumpc();
+
+  if (c == std::streambuf::traits_type::eof())
+    raise_error("unexpected end of input");
+
+  return static_cast<unsigned char>(c);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_bytes(char* buf, std::streamsize n)
+{
+  if (theBuffer->sgetn(buf, n) != n)
+    raise_error("unexpected end of input");
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+uint64_t binary_xdm_loader::read_varint()
+{
+  uint64_t value = 0;
+
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    unsigned char b = read_byte();
+    value |= static_cast<uint64_t>(b & 0x7F) << shift;
+
+    if ((b & 0x80) == 0)
+      return value;
+  }
+
+  raise_error("invalid varint");
+  return 0;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_string(zstring& s)
+{
+  uint64_t len = read_varint();
+
+  s.clear();
+
+  // Grow the string in bounded steps, so that a corrupt length cannot make us
+  // allocate an arbitrary amount of memory up front.
+  char buf[4096];
+  while (len > 0)
+  {
+    std::streamsize n = static_cast<std::streamsize>(
+        len < sizeof(buf) ? len : sizeof(buf));
+    read_bytes(buf, n);
+    s.append(buf, n);
+    len -= n;
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_name(zstring& s)
+{
+  uint64_t ref = read_varint();
+
+  if (ref == 0)
+  {
+    read_string(s);
+    theNames.push_back(s);
+  }
+  else if (ref <= theNames.size())
+  {
+    s = theNames[ref - 1];
+  }
+  else
+  {
+    raise_error("invalid name reference");
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::read_qname(store::Item_t& result)
+{
+  uint64_t ref = read_varint();
+
+  if (ref == 0)
+  {
+    zstring ns;
+    zstring prefix;
+    zstring local;
+    read_name(ns);
+    read_name(prefix);
+    read_name(local);
+
+    GENV_ITEMFACTORY->createQName(result, ns, prefix, local);
+    theQNames.push_back(result);
+  }
+  else if (ref <= theQNames.size())
+  {
+    result = theQNames[ref - 1];
+  }
+  else
+  {
+    raise_error("invalid qname reference");
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void binary_xdm_loader::raise_error(const char* msg)
+{
+  throw ZORBA_EXCEPTION(zerr::ZSTR0020_LOADER_IO_ERROR, ERROR_PARAMS(msg));
+}
+
+
+} // namespace zorba
+
+/*
+ * Local variables:
+ * mode: c++
+ * End:
+ */
+
+/* vim:set et sw=2 ts=2: */
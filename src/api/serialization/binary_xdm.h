@@ -0,0 +1,166 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#ifndef ZORBA_BINARY_XDM_H
+#define ZORBA_BINARY_XDM_H
+
+#include <iostream>
+#include <vector>
+
+#include "common/shared_types.h"
+
+#include "store/api/item.h"
+
+#include "zorbatypes/zstring.h"
+
+
+namespace zorba
+{
+
+/*******************************************************************************
+  The "binary-xdm" encoding of a sequence of XDM and JDM items, written by the
+  serializer's binary_xdm_emitter and read back by binary_xdm_loader.
+
+  sequence := MAGIC VERSION item* END
+
+  item     := ATOMIC typecode value
+            | USER_ATOMIC qname item         (type name, then the base item)
+            | DOCUMENT string string item* END   (base uri, document uri)
+            | ELEMENT qname bindings attrs item* END
+            | ATTRIBUTE qname string
+            | TEXT string
+            | COMMENT string
+            | PI name string
+            | NAMESPACE name name             (prefix, uri)
+            | OBJECT varint (name item)*
+            | ARRAY varint item*
+
+  bindings := varint (name name)*            (prefix, uri)
+  attrs    := varint (qname string)*
+
+  varint   := unsigned LEB128
+  string   := varint byte*
+  name     := varint [string]
+  qname    := varint [name name name]        (namespace, prefix, local name)
+
+  Names and qnames are dictionary-encoded: a reference of 0 is followed by the
+  value itself, which receives the next free id of its dictionary; a reference
+  n > 0 denotes the value with id n-1. Element and attribute names, namespace
+  bindings, PI targets, and object keys are names; all other strings are
+  written in full.
+
+  The value of an ATOMIC item depends on its typecode: xs:boolean is one byte,
+  xs:double and xs:float are the little-endian IEEE 754 bits, the signed
+  bounded integer types are zigzag varints, the unsigned ones are varints,
+  xs:QName and xs:NOTATION are qnames, null is empty, and all other types are
+  their lexical form as a string.
+
+  Nodes are reloaded untyped: element and attribute type annotations are not
+  part of the encoding.
+********************************************************************************/
+namespace binary_xdm
+{
+  const char MAGIC[] = { 'Z', 'X', 'D', 'M' };
+
+  const unsigned char VERSION = 1;
+
+  // The loader reads nested items recursively; it rejects streams that nest
+  // them deeper than this instead of overflowing the stack. The emitter
+  // rejects such items too, so that it never writes a stream that cannot be
+  // read back.
+  const unsigned MAX_DEPTH = 1024;
+
+  enum Tag
+  {
+    END         = 0,
+    ATOMIC      = 1,
+    USER_ATOMIC = 2,
+    DOCUMENT    = 3,
+    ELEMENT     = 4,
+    ATTRIBUTE   = 5,
+    TEXT        = 6,
+    COMMENT     = 7,
+    PI          = 8,
+    NAMESPACE   = 9,
+    OBJECT      = 10,
+    ARRAY       = 11
+  };
+}
+
+
+/*******************************************************************************
+  Reads a sequence in the binary-xdm encoding from a stream and creates the
+  corresponding store items, one top-level item per call to next(). The stream
+  must stay alive for as long as the loader is used.
+********************************************************************************/
+class binary_xdm_loader
+{
+protected:
+  std::streambuf             * theBuffer;
+  bool                         theStarted;
+  bool                         theFinished;
+  unsigned                     theDepth;
+
+  std::vector<zstring>         theNames;
+  std::vector<store::Item_t>   theQNames;
+
+public:
+  binary_xdm_loader(std::istream& is);
+
+  /**
+   * Creates the next top-level item of the sequence.
+   *
+   * @param result the new item
+   * @return false if the end of the sequence has been reached
+   */
+  bool next(store::Item_t& result);
+
+protected:
+  void read_header();
+
+  void read_item(store::Item_t& result, store::Item* parent, int tag);
+
+  void read_atomic(store::Item_t& result);
+
+  void read_children(store::Item* parent);
+
+  unsigned char read_byte();
+
+  void read_bytes(char* buf, std::streamsize n);
+
+  uint64_t read_varint();
+
+  void read_string(zstring& s);
+
+  void read_name(zstring& s);
+
+  void read_qname(store::Item_t& result);
+
+  void raise_error(const char* msg);
+};
+
+
+} // namespace zorba
+
+#endif // #ifdef ZORBA_BINARY_XDM_H
+
+/*
+ * Local variables:
+ * mode: c++
+ * End:
+ */
+
+/* vim:set et sw=2 ts=2: */
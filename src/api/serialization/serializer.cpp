@@ -26,6 +26,7 @@
 
 #include "api/serialization/serializer.h"
 #include "api/serialization/serializable.h"
+#include "api/serialization/binary_xdm.h"
 #include "api/sax2impl.h"
 #include "api/serializerimpl.h"
 #include "api/unmarshaller.h"
@@ -39,8 +40,15 @@
 
 #include "system/globalenv.h"
 
+#ifndef ZORBA_FOR_ONE_THREAD_ONLY
+#include "zorbautils/condition.h"
+#include "zorbautils/mutex.h"
+#include "zorbautils/runnable.h"
+#endif
+
 #include "zorbamisc/ns_consts.h"
 
+#include "zorbatypes/float.h"
 #include "zorbatypes/integer.h"
 #include "zorbatypes/numconversions.h"
 
@@ -467,6 +475,29 @@ void serializer::emitter::emit_item(store::Item* item)
 }
 
 
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::emitter::reset_item_state()
+{
+  thePreviousItemKind = INVALID_ITEM;
+  theIsFirstElementNode = false;
+}
+
+
+/*******************************************************************************
+  Outputs the same separator that emit_item() and emit_node() output in front
+  of a top-level item.
+********************************************************************************/
+void serializer::emitter::emit_item_separator(const store::Item* item)
+{
+  if (item->isAtomic() && thePreviousItemKind == PREVIOUS_ITEM_WAS_TEXT)
+    tr << (ser->item_separator_is_set ? ser->item_separator : " ");
+  else if (thePreviousItemKind)
+    tr << ser->item_separator;
+}
+
+
 /*******************************************************************************
 
 ********************************************************************************/
@@ -971,6 +1002,23 @@ void serializer::json_emitter::emit_item(store::Item *item)
   theMultipleItems = true;
 }
 
+void serializer::json_emitter::reset_item_state()
+{
+  emitter::reset_item_state();
+  theMultipleItems = false;
+}
+
+void serializer::json_emitter::emit_item_separator(const store::Item*)
+{
+  // Top-level JSON items are not separated; only the multiple-items check of
+  // emit_item() applies.
+  if (theMultipleItems && ser->jsoniq_multiple_items == PARAMETER_VALUE_NO)
+  {
+    throw ZORBA_EXCEPTION(jerr::JNSE0012);
+  }
+  theMultipleItems = true;
+}
+
 void serializer::json_emitter::emit_declaration()
 {
 }
@@ -1202,6 +1250,35 @@ void serializer::hybrid_emitter::emit_item(store::Item *item)
   }
 }
 
+void serializer::hybrid_emitter::reset_item_state()
+{
+  json_emitter::reset_item_state();
+  theXMLEmitter->reset_item_state();
+
+  // The XML declaration, if any, is emitted by the master emitter in
+  // emit_item_separator(), so a worker emitter must never be undetermined.
+  theEmitterState = JESTATE_JDM;
+}
+
+void serializer::hybrid_emitter::emit_item_separator(const store::Item* item)
+{
+  if (item->isJSONItem())
+  {
+    theEmitterState = JESTATE_JDM;
+    json_emitter::emit_item_separator(item);
+  }
+  else
+  {
+    if (theEmitterState == JESTATE_UNDETERMINED)
+    {
+      theXMLEmitter->emit_declaration();
+    }
+    theEmitterState = JESTATE_XDM;
+    theXMLEmitter->setPreviousItemKind(thePreviousItemKind);
+    theXMLEmitter->emit_item_separator(item);
+  }
+}
+
 void serializer::hybrid_emitter::emit_end()
 {
   switch(theEmitterState)
@@ -2093,6 +2170,16 @@ void serializer::text_emitter::emit_item(store::Item* item)
 }
 
 
+/*******************************************************************************
+  Top-level nodes are not separated by the text emitter.
+********************************************************************************/
+void serializer::text_emitter::emit_item_separator(const store::Item* item)
+{
+  if (item->isAtomic())
+    emitter::emit_item_separator(item);
+}
+
+
 /*******************************************************************************
 
 ********************************************************************************/
@@ -2242,6 +2329,423 @@ void serializer::binary_emitter::emit_item(store::Item* item)
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//  binary-xdm emitter                                                        //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+/*******************************************************************************
+
+********************************************************************************/
+serializer::binary_xdm_emitter::binary_xdm_emitter(
+    serializer* the_serializer,
+    std::ostream& the_stream)
+  :
+  emitter(the_serializer, the_stream),
+  theDepth(0)
+{
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::emit_declaration()
+{
+  tr.write(binary_xdm::MAGIC, sizeof(binary_xdm::MAGIC));
+  tr.put(binary_xdm::VERSION);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::emit_end()
+{
+  tr.put(binary_xdm::END);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::emit_item(store::Item* item)
+{
+  theDepth = 0;
+  write_item(item);
+}
+
+
+/*******************************************************************************
+  Items that nest deeper than binary_xdm::MAX_DEPTH are rejected, as the loader
+  would reject them when reading the stream back.
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_item(const store::Item* item)
+{
+  if (theDepth == binary_xdm::MAX_DEPTH)
+  {
+    throw ZORBA_EXCEPTION(err::SENR0001,
+    ERROR_PARAMS(item->getType()->getStringValue(),
+                 BUILD_STRING("binary-xdm items nested more than ",
+                              binary_xdm::MAX_DEPTH, " deep")));
+  }
+
+  ++theDepth;
+
+  if (item->isAtomic())
+  {
+    const store::Item* baseItem = item->getBaseItem();
+    if (baseItem != NULL)
+    {
+      tr.put(binary_xdm::USER_ATOMIC);
+      write_qname(item->getType());
+      write_atomic(baseItem);
+    }
+    else
+    {
+      write_atomic(item);
+    }
+  }
+  else if (item->isNode())
+  {
+    write_node(item);
+  }
+  else if (item->isObject())
+  {
+    tr.put(binary_xdm::OBJECT);
+    write_varint(to_xs_unsignedLong(item->getNumObjectPairs()));
+
+    store::Item_t key;
+    store::Iterator_t it = item->getObjectKeys();
+    it->open();
+    while (it->next(key))
+    {
+      write_name(key->getStringValue());
+      write_item(item->getObjectValue(key).getp());
+    }
+    it->close();
+  }
+  else if (item->isArray())
+  {
+    tr.put(binary_xdm::ARRAY);
+    write_varint(to_xs_unsignedLong(item->getArraySize()));
+
+    store::Item_t member;
+    store::Iterator_t it = item->getArrayValues();
+    it->open();
+    while (it->next(member))
+    {
+      write_item(member.getp());
+    }
+    it->close();
+  }
+  else
+  {
+    throw ZORBA_EXCEPTION(err::SENR0001,
+    ERROR_PARAMS(item->show(), "binary-xdm"));
+  }
+
+  --theDepth;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_atomic(const store::Item* item)
+{
+  store::SchemaTypeCode typeCode = item->getTypeCode();
+
+  tr.put(binary_xdm::ATOMIC);
+  tr.put(static_cast<char>(typeCode));
+
+  switch (typeCode)
+  {
+  case store::XS_BOOLEAN:
+  {
+    tr.put(item->getBooleanValue() ? 1 : 0);
+    break;
+  }
+  case store::XS_DOUBLE:
+  {
+    double value = item->getDoubleValue().getNumber();
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i)
+      tr.put(static_cast<char>(bits >> (8 * i)));
+    break;
+  }
+  case store::XS_FLOAT:
+  {
+    float value = item->getFloatValue().getNumber();
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 4; ++i)
+      tr.put(static_cast<char>(bits >> (8 * i)));
+    break;
+  }
+  case store::XS_LONG:
+  case store::XS_INT:
+  case store::XS_SHORT:
+  case store::XS_BYTE:
+  {
+    int64_t value;
+    if (typeCode == store::XS_LONG)
+      value = item->getLongValue();
+    else if (typeCode == store::XS_INT)
+      value = item->getIntValue();
+    else if (typeCode == store::XS_SHORT)
+      value = item->getShortValue();
+    else
+      value = item->getByteValue();
+
+    // zigzag encoding, so that small negative values get short varints
+    write_varint((static_cast<uint64_t>(value) << 1) ^
+                 static_cast<uint64_t>(value >> 63));
+    break;
+  }
+  case store::XS_UNSIGNED_LONG:
+  {
+    write_varint(item->getUnsignedLongValue());
+    break;
+  }
+  case store::XS_UNSIGNED_INT:
+  {
+    write_varint(item->getUnsignedIntValue());
+    break;
+  }
+  case store::XS_UNSIGNED_SHORT:
+  {
+    write_varint(item->getUnsignedShortValue());
+    break;
+  }
+  case store::XS_UNSIGNED_BYTE:
+  {
+    write_varint(item->getUnsignedByteValue());
+    break;
+  }
+  case store::XS_QNAME:
+  {
+    write_qname(item);
+    break;
+  }
+  case store::XS_NOTATION:
+  {
+    store::Item_t qname;
+    GENV_ITEMFACTORY->createQName(qname,
+                                  item->getNamespace(),
+                                  item->getPrefix(),
+                                  item->getLocalName());
+    write_qname(qname.getp());
+    break;
+  }
+  case store::JS_NULL:
+  {
+    break;
+  }
+  default:
+  {
+    zstring value;
+    item->getStringValue2(value);
+    write_string(value);
+  }
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_node(const store::Item* item)
+{
+  switch (item->getNodeKind())
+  {
+  case store::StoreConsts::documentNode:
+  {
+    zstring baseUri;
+    zstring docUri;
+    item->getBaseURI(baseUri);
+    item->getDocumentURI(docUri);
+
+    tr.put(binary_xdm::DOCUMENT);
+    write_string(baseUri);
+    write_string(docUri);
+    write_children(item);
+    break;
+  }
+  case store::StoreConsts::elementNode:
+  {
+    tr.put(binary_xdm::ELEMENT);
+    write_qname(item->getNodeName());
+
+    store::NsBindings bindings;
+    item->getNamespaceBindings(bindings, store::StoreConsts::ONLY_LOCAL_BINDINGS);
+
+    write_varint(bindings.size());
+    for (store::NsBindings::const_iterator ite = bindings.begin();
+         ite != bindings.end();
+         ++ite)
+    {
+      write_name(ite->first);
+      write_name(ite->second);
+    }
+
+    std::vector<store::Item_t> attrs;
+    store::Item_t attr;
+    store::Iterator_t it = item->getAttributes();
+    it->open();
+    while (it->next(attr))
+    {
+      attrs.push_back(attr);
+    }
+    it->close();
+
+    write_varint(attrs.size());
+    for (std::vector<store::Item_t>::const_iterator ite = attrs.begin();
+         ite != attrs.end();
+         ++ite)
+    {
+      write_qname((*ite)->getNodeName());
+      write_string((*ite)->getStringValue());
+    }
+
+    write_children(item);
+    break;
+  }
+  case store::StoreConsts::attributeNode:
+  {
+    tr.put(binary_xdm::ATTRIBUTE);
+    write_qname(item->getNodeName());
+    write_string(item->getStringValue());
+    break;
+  }
+  case store::StoreConsts::textNode:
+  {
+    zstring content;
+    item->getStringValue2(content);
+
+    tr.put(binary_xdm::TEXT);
+    write_string(content);
+    break;
+  }
+  case store::StoreConsts::commentNode:
+  {
+    tr.put(binary_xdm::COMMENT);
+    write_string(item->getStringValue());
+    break;
+  }
+  case store::StoreConsts::piNode:
+  {
+    tr.put(binary_xdm::PI);
+    write_name(item->getTarget());
+    write_string(item->getStringValue());
+    break;
+  }
+  case store::StoreConsts::namespaceNode:
+  {
+    tr.put(binary_xdm::NAMESPACE);
+    write_name(item->getNamespacePrefix());
+    write_name(item->getStringValue());
+    break;
+  }
+  default:
+  {
+    ZORBA_ASSERT(false);
+  }
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_children(const store::Item* item)
+{
+  store::Item_t child;
+  store::Iterator_t it = item->getChildren();
+  it->open();
+  while (it->next(child))
+  {
+    write_item(child.getp());
+  }
+  it->close();
+
+  tr.put(binary_xdm::END);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_varint(uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    tr.put(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  tr.put(static_cast<char>(value));
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_string(const zstring& s)
+{
+  write_varint(s.size());
+  tr.write(s.data(), s.size());
+}
+
+
+/*******************************************************************************
+  Writes a reference to s in the name dictionary, preceded by s itself if this
+  is the first occurrence of s.
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_name(const zstring& s)
+{
+  std::pair<name_map::iterator, bool> ins =
+  theNames.insert(name_map::value_type(s, theNames.size()));
+
+  if (ins.second)
+  {
+    write_varint(0);
+    write_string(s);
+  }
+  else
+  {
+    write_varint(ins.first->second + 1);
+  }
+}
+
+
+/*******************************************************************************
+  Same as write_name() for the qname dictionary. The store shares qname items,
+  so they are looked up by address; distinct items for the same qname simply
+  get distinct ids.
+********************************************************************************/
+void serializer::binary_xdm_emitter::write_qname(const store::Item* qname)
+{
+  std::pair<qname_map::iterator, bool> ins =
+  theQNames.insert(qname_map::value_type(qname, theQNames.size()));
+
+  if (ins.second)
+  {
+    theQNameItems.push_back(const_cast<store::Item*>(qname));
+    write_varint(0);
+    write_name(qname->getNamespace());
+    write_name(qname->getPrefix());
+    write_name(qname->getLocalName());
+  }
+  else
+  {
+    write_varint(ins.first->second + 1);
+  }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //                                                                            //
 //  Serializer                                                                //
@@ -2309,6 +2813,8 @@ void serializer::reset()
   version_has_default_value = true;
 
   indent = PARAMETER_VALUE_NO;
+
+  parallel_threads = 0;
 }
 
 static short int
@@ -2327,6 +2833,8 @@ convertMethodString(const char* aValue, const char* aName) {
     return serializer::PARAMETER_VALUE_JSON;
   else if (!strcmp(aValue, "json-xml-hybrid"))
     return serializer::PARAMETER_VALUE_JSON_XML_HYBRID;
+  else if (!strcmp(aValue, "binary-xdm"))
+    return serializer::PARAMETER_VALUE_BINARY_XDM;
   else
     throw ZORBA_EXCEPTION(
       err::SEPM0016, ERROR_PARAMS( aValue, aName, ZED( GoodValuesAreXMLEtc ) )
@@ -2334,6 +2842,14 @@ convertMethodString(const char* aValue, const char* aName) {
 }
 
 
+/*******************************************************************************
+  Largest accepted value of the parallel-threads parameter. The parameter may
+  come from a query, so it must not let it make the process create any number
+  of threads.
+********************************************************************************/
+static const ulong PARALLEL_MAX_THREADS = 16;
+
+
 /*******************************************************************************
 
 ********************************************************************************/
@@ -2474,6 +2990,23 @@ void serializer::setParameter(const char* aName, const char* aValue)
   {
     jsoniq_xdm_method = convertMethodString(aValue, aName);
   }
+  else if (!strcmp(aName, "parallel-threads"))
+  {
+    ulong threads;
+    try
+    {
+      threads = ztd::aton<ulong>(aValue);
+    }
+    catch (std::exception const&)
+    {
+      throw ZORBA_EXCEPTION( err::SEPM0016, ERROR_PARAMS( aValue, aName ) );
+    }
+
+    if (threads > PARALLEL_MAX_THREADS)
+      throw ZORBA_EXCEPTION( err::SEPM0016, ERROR_PARAMS( aValue, aName ) );
+
+    parallel_threads = threads;
+  }
   else
   {
     throw ZORBA_EXCEPTION( err::SEPM0016, ERROR_PARAMS( aValue, aName ) );
@@ -2495,6 +3028,7 @@ void serializer::getSerializationMethod(zstring& m) const
     case PARAMETER_VALUE_BINARY: m = "binary"; break;
     case PARAMETER_VALUE_JSON: m = "json"; break;
     case PARAMETER_VALUE_JSON_XML_HYBRID: m = "json-xml-hybrid"; break;
+    case PARAMETER_VALUE_BINARY_XDM: m = "binary-xdm"; break;
     default: ZORBA_ASSERT(false);
   }
 }
@@ -2570,28 +3104,41 @@ serializer::validate_parameters(void)
 /*******************************************************************************
 
 ********************************************************************************/
-bool serializer::setup(std::ostream& os, bool aEmitAttributes)
+serializer::emitter* serializer::create_emitter(
+    std::ostream& os,
+    bool aEmitAttributes)
 {
-  tr = &os;
   if (method == PARAMETER_VALUE_XML)
-    e = new xml_emitter(this, *tr, aEmitAttributes);
+    return new xml_emitter(this, os, aEmitAttributes);
   else if (method == PARAMETER_VALUE_HTML)
-    e = new html_emitter(this, *tr);
+    return new html_emitter(this, os);
   else if (method == PARAMETER_VALUE_XHTML)
-    e = new xhtml_emitter(this, *tr);
+    return new xhtml_emitter(this, os);
   else if (method == PARAMETER_VALUE_TEXT)
-    e = new text_emitter(this, *tr);
+    return new text_emitter(this, os);
   else if (method == PARAMETER_VALUE_BINARY)
-    e = new binary_emitter(this, *tr);
+    return new binary_emitter(this, os);
   else if (method == PARAMETER_VALUE_JSON)
-    e = new json_emitter(this, *tr);
+    return new json_emitter(this, os);
   else if (method == PARAMETER_VALUE_JSON_XML_HYBRID)
-    e = new hybrid_emitter(this, *tr, aEmitAttributes);
-  else
-  {
-    ZORBA_ASSERT(0);
+    return new hybrid_emitter(this, os, aEmitAttributes);
+  else if (method == PARAMETER_VALUE_BINARY_XDM)
+    return new binary_xdm_emitter(this, os);
+
+  ZORBA_ASSERT(0);
+  return nullptr;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool serializer::setup(std::ostream& os, bool aEmitAttributes)
+{
+  tr = &os;
+  e = create_emitter(*tr, aEmitAttributes);
+  if (e == nullptr)
     return false;
-  }
 
   if (!cdata_section_elements.empty())
   {
@@ -2668,19 +3215,28 @@ serializer::serialize(
 
     e->emit_declaration();
 
-    store::Item_t lItem;
-    //+  aObject->open();
-    while (aObject->next(lItem))
+#ifndef ZORBA_FOR_ONE_THREAD_ONLY
+    if (!aHandler && can_serialize_in_parallel())
     {
-      // PUL's cannot be serialized
-      if (lItem->isPul())
+      serialize_in_parallel(aObject, aEmitAttributes);
+    }
+    else
+#endif
+    {
+      store::Item_t lItem;
+      //+  aObject->open();
+      while (aObject->next(lItem))
       {
-        throw ZORBA_EXCEPTION(zerr::ZAPI0007_CANNOT_SERIALIZE_PUL);
-      }
+        // PUL's cannot be serialized
+        if (lItem->isPul())
+        {
+          throw ZORBA_EXCEPTION(zerr::ZAPI0007_CANNOT_SERIALIZE_PUL);
+        }
 
-      e->emit_item(&*lItem);
+        e->emit_item(&*lItem);
+      }
+      //+  aObject->close();
     }
-  //+  aObject->close();
     e->emit_end();
     transcode::detach( aOStream );
   }
@@ -2743,5 +3299,370 @@ void serializer::serialize(
   }
 }
 
+
+#ifndef ZORBA_FOR_ONE_THREAD_ONLY
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+//  Parallel serialization                                                    //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+
+/*******************************************************************************
+  Number of top-level items per worker thread that may be serialized ahead of
+  the item that is currently written to the output. It bounds the memory held
+  by item buffers that are finished but not yet written.
+********************************************************************************/
+static const ulong PARALLEL_ITEMS_PER_THREAD = 4;
+
+
+/*******************************************************************************
+  A bounded window of top-level items that are being serialized concurrently.
+
+  The master thread pushes the items of the result sequence in order. Worker
+  threads take them in that same order, serialize each one into the buffer of
+  its slot, and mark the slot as done. The master thread writes the buffers to
+  the output in order, waiting for a slot whose item is still being serialized.
+  The slot of the i-th item is theSlots[i % theSlots.size()].
+
+  theNumPushed and theNumWritten are modified by the master thread only, so
+  is_full() and is_empty() do not need to lock the mutex.
+********************************************************************************/
+class serializer::parallel_queue
+{
+public:
+  struct slot
+  {
+    store::Item_t                    theItem;
+    std::string                      theBuffer;
+    emitter::ItemState               theItemKind;
+    std::unique_ptr<ZorbaException>  theError;
+    bool                             theIsDone;
+  };
+
+protected:
+  Mutex                theMutex;
+  Condition            theWorkCondition;
+  Condition            theDoneCondition;
+  std::vector<slot*>   theSlots;
+  ulong                theNumPushed;
+  ulong                theNumTaken;
+  ulong                theNumWritten;
+  bool                 theIsClosed;
+
+public:
+  parallel_queue(ulong size);
+
+  ~parallel_queue();
+
+  bool is_full() const { return theNumPushed - theNumWritten == theSlots.size(); }
+
+  bool is_empty() const { return theNumPushed == theNumWritten; }
+
+  void push(const store::Item_t& item);
+
+  slot* take();
+
+  void done(slot* s);
+
+  slot* front();
+
+  void pop();
+
+  void close();
+};
+
+
+serializer::parallel_queue::parallel_queue(ulong size)
+  :
+  theWorkCondition(theMutex),
+  theDoneCondition(theMutex),
+  theSlots(size),
+  theNumPushed(0),
+  theNumTaken(0),
+  theNumWritten(0),
+  theIsClosed(false)
+{
+  for (ulong i = 0; i < size; ++i)
+    theSlots[i] = new slot;
+}
+
+
+serializer::parallel_queue::~parallel_queue()
+{
+  for (ulong i = 0; i < theSlots.size(); ++i)
+    delete theSlots[i];
+}
+
+
+/*******************************************************************************
+  Called by the master thread, when the window is not full.
+********************************************************************************/
+void serializer::parallel_queue::push(const store::Item_t& item)
+{
+  AutoMutex lock(&theMutex);
+
+  slot* s = theSlots[theNumPushed % theSlots.size()];
+  s->theItem = item;
+  s->theIsDone = false;
+  ++theNumPushed;
+
+  theWorkCondition.signal();
+}
+
+
+/*******************************************************************************
+  Called by a worker thread. Blocks until there is an item that no worker has
+  taken yet, and returns its slot, or NULL if the queue has been closed.
+********************************************************************************/
+serializer::parallel_queue::slot* serializer::parallel_queue::take()
+{
+  AutoMutex lock(&theMutex);
+
+  while (theNumTaken == theNumPushed && !theIsClosed)
+    theWorkCondition.wait();
+
+  if (theIsClosed)
+    return NULL;
+
+  return theSlots[theNumTaken++ % theSlots.size()];
+}
+
+
+/*******************************************************************************
+  Called by a worker thread, after it has filled in the given slot.
+********************************************************************************/
+void serializer::parallel_queue::done(slot* s)
+{
+  AutoMutex lock(&theMutex);
+
+  s->theIsDone = true;
+
+  theDoneCondition.signal();
+}
+
+
+/*******************************************************************************
+  Called by the master thread, when the window is not empty. Blocks until the
+  oldest item in the window has been serialized, and returns its slot.
+********************************************************************************/
+serializer::parallel_queue::slot* serializer::parallel_queue::front()
+{
+  AutoMutex lock(&theMutex);
+
+  slot* s = theSlots[theNumWritten % theSlots.size()];
+
+  while (!s->theIsDone)
+    theDoneCondition.wait();
+
+  return s;
+}
+
+
+/*******************************************************************************
+  Called by the master thread, after it has written the slot returned by
+  front().
+********************************************************************************/
+void serializer::parallel_queue::pop()
+{
+  AutoMutex lock(&theMutex);
+
+  slot* s = theSlots[theNumWritten % theSlots.size()];
+  s->theItem = NULL;
+  s->theBuffer.clear();
+  s->theError.reset();
+  ++theNumWritten;
+}
+
+
+/*******************************************************************************
+  Called by the master thread, when all items have been written or when the
+  serialization is aborted. Makes all workers return from take().
+********************************************************************************/
+void serializer::parallel_queue::close()
+{
+  AutoMutex lock(&theMutex);
+
+  theIsClosed = true;
+
+  theWorkCondition.broadcast();
+}
+
+
+/*******************************************************************************
+  A worker thread of the parallel serializer. It owns an emitter of the same
+  method as the master emitter, which writes to a private string stream.
+********************************************************************************/
+class serializer::parallel_worker : public Runnable
+{
+protected:
+  parallel_queue     & theQueue;
+  std::ostringstream   theStream;
+  rchandle<emitter>    theEmitter;
+
+public:
+  parallel_worker(
+      serializer* ser,
+      parallel_queue& queue,
+      bool aEmitAttributes)
+    :
+    theQueue(queue),
+    theEmitter(ser->create_emitter(theStream, aEmitAttributes))
+  {
+  }
+
+  virtual void run();
+
+  virtual void finish() {}
+};
+
+
+/*******************************************************************************
+  Errors are passed to the master thread, which raises them when it reaches
+  the failed item. The worker stops after an error, because its emitter may be
+  left in an inconsistent state; all the items that precede the failed one
+  have already been taken by other workers.
+********************************************************************************/
+void serializer::parallel_worker::run()
+{
+  parallel_queue::slot* s;
+
+  while ((s = theQueue.take()) != NULL)
+  {
+    bool failed = false;
+
+    try
+    {
+      theEmitter->reset_item_state();
+      theEmitter->emit_item(s->theItem.getp());
+      s->theItemKind = theEmitter->getPreviousItemKind();
+    }
+    catch (ZorbaException const& e)
+    {
+      s->theError = clone(e);
+      failed = true;
+    }
+    catch (std::exception const& e)
+    {
+      s->theError = clone(ZORBA_EXCEPTION(zerr::ZXQP0003_INTERNAL_ERROR,
+                                          ERROR_PARAMS(e.what())));
+      failed = true;
+    }
+
+    s->theBuffer = theStream.str();
+    theStream.str("");
+
+    theQueue.done(s);
+
+    if (failed)
+      break;
+  }
+}
+
+
+/*******************************************************************************
+  Parallel serialization is possible only if every top-level item serializes
+  to the same bytes no matter which items precede it, except for what
+  emitter::emit_item_separator() outputs, and if the item buffers can be
+  concatenated without being re-encoded.
+********************************************************************************/
+bool serializer::can_serialize_in_parallel() const
+{
+  if (parallel_threads == 0)
+    return false;
+
+  switch (method)
+  {
+  case PARAMETER_VALUE_JSON:
+    return true;
+
+  case PARAMETER_VALUE_XML:
+  case PARAMETER_VALUE_TEXT:
+  case PARAMETER_VALUE_JSON_XML_HYBRID:
+    return (indent == PARAMETER_VALUE_NO &&
+            doctype_system.empty() &&
+            !item_separator_is_set &&
+            !transcode::is_necessary(encoding.c_str()));
+
+  default:
+    return false;
+  }
+}
+
+
+/*******************************************************************************
+  Serializes the items of the given sequence with parallel_threads worker
+  threads, each into its own buffer, and writes the buffers to the output in
+  sequence order. The emitter e has already emitted the declaration and will
+  emit the end of the output.
+********************************************************************************/
+void serializer::serialize_in_parallel(
+    store::Iterator_t aObject,
+    bool aEmitAttributes)
+{
+  parallel_queue queue(parallel_threads * PARALLEL_ITEMS_PER_THREAD);
+
+  std::vector<parallel_worker*> workers(parallel_threads);
+
+  for (ulong i = 0; i < parallel_threads; ++i)
+  {
+    workers[i] = new parallel_worker(this, queue, aEmitAttributes);
+    workers[i]->start();
+  }
+
+  try
+  {
+    store::Item_t lItem;
+    bool haveItem = aObject->next(lItem);
+
+    while (haveItem || !queue.is_empty())
+    {
+      if (haveItem && !queue.is_full())
+      {
+        // PUL's cannot be serialized
+        if (lItem->isPul())
+        {
+          throw ZORBA_EXCEPTION(zerr::ZAPI0007_CANNOT_SERIALIZE_PUL);
+        }
+
+        queue.push(lItem);
+        haveItem = aObject->next(lItem);
+        continue;
+      }
+
+      parallel_queue::slot* s = queue.front();
+
+      if (s->theError)
+        s->theError->polymorphic_throw();
+
+      e->emit_item_separator(s->theItem.getp());
+      tr->write(s->theBuffer.data(), s->theBuffer.size());
+      e->setPreviousItemKind(s->theItemKind);
+
+      queue.pop();
+    }
+  }
+  catch (...)
+  {
+    queue.close();
+    for (ulong i = 0; i < parallel_threads; ++i)
+    {
+      workers[i]->join();
+      delete workers[i];
+    }
+    throw;
+  }
+
+  queue.close();
+  for (ulong i = 0; i < parallel_threads; ++i)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+}
+
+#endif /* ZORBA_FOR_ONE_THREAD_ONLY */
+
 } // namespace zorba
 /* vim:set et sw=2 ts=2: */
@@ -24,6 +24,9 @@
 
 #include "zorbatypes/schema_types.h"
 
+#include "util/hash/hash.h"
+#include "util/unordered_map.h"
+
 #include "common/shared_types.h"
 
 #include "store/api/item.h"
@@ -55,6 +58,10 @@ class serializer : public SimpleRCObject
 {
 protected:
   class emitter;
+#ifndef ZORBA_FOR_ONE_THREAD_ONLY
+  class parallel_queue;
+  class parallel_worker;
+#endif
 
 public:
   typedef enum
@@ -70,6 +77,7 @@ public:
     PARAMETER_VALUE_BINARY,
     PARAMETER_VALUE_JSON,
     PARAMETER_VALUE_JSON_XML_HYBRID,
+    PARAMETER_VALUE_BINARY_XDM,
 
     // Values for the XML/HTML version
     PARAMETER_VALUE_VERSION_1_0,          // used for XML 1.0
@@ -113,6 +121,9 @@ protected:
   short int jsoniq_xdm_method;      // A legal value for "method", implemented
   bool version_has_default_value;  // Used during validation to set version to
                                    // "4.0" when output method is "html"
+  ulong parallel_threads;          // Zorba extension: number of worker threads
+                                   // that serialize top-level items
+                                   // concurrently; 0 means sequential
   rchandle<emitter>    e;
   std::ostream         *tr;
 
@@ -190,8 +201,16 @@ protected:
 
   bool setup(std::ostream& os, bool aEmitAttributes = false);
 
+  emitter* create_emitter(std::ostream& os, bool aEmitAttributes);
+
   void attach_transcoder(std::ostream& os);
 
+#ifndef ZORBA_FOR_ONE_THREAD_ONLY
+  bool can_serialize_in_parallel() const;
+
+  void serialize_in_parallel(store::Iterator_t object, bool aEmitAttributes);
+#endif
+
   ///////////////////////////////////////////////////////////
   //                                                       //
   //  class emitter                                        //
@@ -201,16 +220,20 @@ protected:
   class emitter : public SimpleRCObject
   {
   protected:
-    serializer                          * ser;
-    std::ostream                        & tr;
-    std::vector<store::NsBindings>        theBindings;
-
+  public:
     enum ItemState
     {
       INVALID_ITEM,
       PREVIOUS_ITEM_WAS_TEXT,
       PREVIOUS_ITEM_WAS_NODE
-    }                                     thePreviousItemKind;
+    };
+
+  protected:
+    serializer                          * ser;
+    std::ostream                        & tr;
+    std::vector<store::NsBindings>        theBindings;
+
+    ItemState                             thePreviousItemKind;
 
     std::vector<store::ChildrenIterator*> theChildIters;
     ulong                                 theFirstFreeChildIter;
@@ -258,6 +281,25 @@ protected:
 
     void setPreviousItemKind(ItemState v) { thePreviousItemKind = v; }
 
+    /**
+     * Used by the parallel serializer on a worker emitter, before the worker
+     * serializes a top-level item into its own buffer. Resets the state that
+     * carries over from one top-level item to the next, so that the worker
+     * emits neither a leading item separator nor a declaration or doctype.
+     */
+    virtual void reset_item_state();
+
+    /**
+     * Used by the parallel serializer on the master emitter, before it copies
+     * the buffer produced by a worker for the given top-level item to the
+     * output. Outputs whatever emit_item() would have output before the item
+     * itself (item separator, deferred declaration) and performs the checks
+     * that depend on the preceding items.
+     *
+     * @param item the top-level item whose buffer follows
+     */
+    virtual void emit_item_separator(const store::Item* item);
+
     // End of the "public" emitter API. All remaining methods are implementation
     // details and will not be called from outside.
 
@@ -379,6 +421,10 @@ protected:
 
     virtual void emit_end();
 
+    virtual void reset_item_state();
+
+    virtual void emit_item_separator(const store::Item* item);
+
   protected:
 
     /**
@@ -427,6 +473,10 @@ protected:
 
     virtual void emit_end();
 
+    virtual void reset_item_state();
+
+    virtual void emit_item_separator(const store::Item* item);
+
   protected:
     virtual void emit_jsoniq_xdm_node(store::Item* item, int);
 
@@ -496,6 +546,8 @@ protected:
 
     virtual void emit_item(store::Item* item);
 
+    virtual void emit_item_separator(const store::Item* item);
+
   protected:
     virtual void emit_node(const store::Item* item, int depth);
 
@@ -573,6 +625,51 @@ protected:
 
     void emit_item(store::Item* item);
   };
+
+
+  ///////////////////////////////////////////////////////////
+  //                                                       //
+  //  class binary_xdm_emitter                             //
+  //                                                       //
+  ///////////////////////////////////////////////////////////
+
+  class binary_xdm_emitter : public emitter
+  {
+  protected:
+    typedef std::unordered_map<zstring, ulong> name_map;
+    typedef std::unordered_map<const store::Item*, ulong> qname_map;
+
+    name_map                     theNames;
+    qname_map                    theQNames;
+    std::vector<store::Item_t>   theQNameItems;  // keeps the keys of theQNames alive
+    unsigned                     theDepth;
+
+  public:
+    binary_xdm_emitter(serializer* the_serializer, std::ostream& the_stream);
+
+    void emit_declaration();
+
+    void emit_end();
+
+    void emit_item(store::Item* item);
+
+  protected:
+    void write_item(const store::Item* item);
+
+    void write_atomic(const store::Item* item);
+
+    void write_node(const store::Item* item);
+
+    void write_children(const store::Item* item);
+
+    void write_varint(uint64_t value);
+
+    void write_string(const zstring& s);
+
+    void write_name(const zstring& s);
+
+    void write_qname(const store::Item* qname);
+  };
 };
 
 
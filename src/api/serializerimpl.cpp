@@ -23,9 +23,12 @@
 #include <diagnostics/assert.h>
 #include <api/zorbaimpl.h>
 #include <api/unmarshaller.h>
+#include <api/item_seq_binary_xdm.h>
 
 #include "serializerimpl.h"
 
+#include "util/string_util.h"
+
 namespace zorba {
 
 Serializer_t
@@ -40,6 +43,12 @@ Serializer::createSerializer(ItemSequence* aOptions)
   return new SerializerImpl(aOptions);
 }
 
+ItemSequence_t
+Serializer::parseBinaryXDM(std::istream& aStream)
+{
+  return new BinaryXDMItemSequence(aStream);
+}
+
 SerializerImpl::SerializerImpl(const Zorba_SerializerOptions_t& aOptions, DiagnosticHandler* aDiagnosticHandler)
   : theDiagnosticHandler(aDiagnosticHandler),
     theInternalSerializer(&theXQueryDiagnostics)
@@ -115,6 +124,8 @@ SerializerImpl::getSerializationMethod() const
     return ZORBA_SERIALIZATION_METHOD_JSON;
   case serializer::PARAMETER_VALUE_JSON_XML_HYBRID:
     return ZORBA_SERIALIZATION_METHOD_JSON_XML_HYBRID;
+  case serializer::PARAMETER_VALUE_BINARY_XDM:
+    return ZORBA_SERIALIZATION_METHOD_BINARY_XDM;
   default:
     ZORBA_ASSERT(0);
   }
@@ -142,6 +153,8 @@ convertSerializationMethod(
     aInternalSerializer.setParameter(aParameter, "json"); break;
   case ZORBA_SERIALIZATION_METHOD_JSON_XML_HYBRID:
     aInternalSerializer.setParameter(aParameter, "json-xml-hybrid"); break;
+  case ZORBA_SERIALIZATION_METHOD_BINARY_XDM:
+    aInternalSerializer.setParameter(aParameter, "binary-xdm"); break;
   }
 }
 
@@ -237,6 +250,13 @@ SerializerImpl::setSerializationParameters(
   convertSerializationMethod(aInternalSerializer,
                              "jsoniq-xdm-node-output-method",
                              aSerializerOptions.jsoniq_xdm_method);
+
+  if (aSerializerOptions.parallel_threads)
+  {
+    zstring lThreads;
+    ztd::to_string(aSerializerOptions.parallel_threads, &lThreads);
+    aInternalSerializer.setParameter("parallel-threads", lThreads.c_str());
+  }
 }
 
 void
@@ -62,6 +62,7 @@
 #include "runtime/visitors/iterprinter.h"
 #include "runtime/sequences/SequencesImpl.h"
 #include "runtime/sequences/sequences.h"
+#include "runtime/accessors/accessors.h"
 #include "runtime/core/sequencetypes.h"
 #include "runtime/core/item_iterator.h"
 #include "runtime/core/var_iterators.h"
@@ -2107,13 +2108,28 @@ void end_visit(promote_expr& v)
 {
   CODEGEN_TRACE_OUT("");
   PlanIter_t child = pop_itstack();
+  bool atomize = false;
+
+  // Fuse promote(data(E)), the conversion of a function argument to an atomic
+  // param type, into a single iterator that atomizes and promotes.
+  FnDataIterator* dataIte = dynamic_cast<FnDataIterator*>(child.getp());
+
+  if (dataIte != NULL && dataIte->getChildren().size() == 1)
+  {
+    // Take the input before releasing the data iterator, which owns it.
+    PlanIter_t input = dataIte->getChildren()[0];
+    child = input;
+    atomize = true;
+  }
+
   // TODO: Currently we use cast. Promotion may be more efficient.
   push_itstack(new PromoteIterator(sctx,
                                    qloc,
                                    child,
                                    v.get_target_type(),
                                    v.get_err(),
-                                   v.get_qname()));
+                                   v.get_qname(),
+                                   atomize));
 }
 
 
@@ -2614,7 +2630,8 @@ void end_visit(cast_expr& v)
                                 qloc,
                                 child,
                                 v.get_target_type(),
-                                v.allows_empty_input()));
+                                v.allows_empty_input(),
+                                v.get_input()->get_return_type()));
 }
 
 
@@ -2946,6 +2963,54 @@ bool begin_visit(axis_step_expr& v)
 void end_visit(axis_step_expr& v)
 {
   CODEGEN_TRACE_OUT("");
+
+  if (v.getAxis() == axis_kind_descendant)
+    fuse_descendant_steps();
+}
+
+
+/*******************************************************************************
+  If the iterator at the top of the stack is a descendant step whose input is
+  another descendant step (or a chain of them), replace the steps with a single
+  DescendantPathIterator, which evaluates the whole chain in one walk over the
+  input trees and without producing duplicates.
+********************************************************************************/
+void fuse_descendant_steps()
+{
+  PlanIter_t ite = pop_itstack();
+
+  DescendantAxisIterator* step = dynamic_cast<DescendantAxisIterator*>(ite.getp());
+
+  if (step != NULL &&
+      step->getTestKind() != match_doc_test &&
+      step->getTargetPos() < 0)
+  {
+    PlanIter_t input = step->getChild();
+
+    DescendantAxisIterator* inputStep =
+    dynamic_cast<DescendantAxisIterator*>(input.getp());
+
+    DescendantPathIterator* inputPath =
+    dynamic_cast<DescendantPathIterator*>(input.getp());
+
+    if (inputStep != NULL &&
+        inputStep->getTestKind() != match_doc_test &&
+        inputStep->getTargetPos() < 0)
+    {
+      ite = new DescendantPathIterator(step->getStaticContext(),
+                                       step->getLocation(),
+                                       inputStep->getChild(),
+                                       *inputStep,
+                                       *step);
+    }
+    else if (inputPath != NULL)
+    {
+      inputPath->addStep(*step);
+      ite = input;
+    }
+  }
+
+  push_itstack(ite.getp());
 }
 
 
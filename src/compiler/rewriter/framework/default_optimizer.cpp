@@ -149,6 +149,27 @@ bool DefaultOptimizer::rewrite(RewriterContext& rCtx)
     goto repeat4;
   }
 
+  // Common subexpression elimination. Done before loop hoisting, so that the
+  // let vars it creates may be hoisted further out of the loops.
+  if (Properties::instance().getLoopHoisting())
+  {
+    RuleOnceDriver<EliminateCommonSubexprs> driverEliminateCommonSubexprs;
+
+    if (driverEliminateCommonSubexprs.rewrite(rCtx))
+    {
+      modified = true;
+
+      if (Properties::instance().getPrintIntermediateOpt())
+      {
+        std::cout << "After common subexpression elimination : " << std::endl;
+        rCtx.getRoot()->put(std::cout) << std::endl;
+      }
+
+      RuleOnceDriver<MarkExprs> driverMarkExpr;
+      driverMarkExpr.rewrite(rCtx);
+    }
+  }
+
   // Loop Hoisting
   if (Properties::instance().getLoopHoisting())
   {
@@ -257,6 +278,23 @@ bool DefaultOptimizer::rewrite(RewriterContext& rCtx)
     while (local_modified);
   }
 
+  // Collection filters. Done after index matching and index joins, because
+  // those rules look for plain collection() calls.
+  {
+    RuleOnceDriver<PushCollectionFilters> driverPushCollectionFilters;
+
+    if (driverPushCollectionFilters.rewrite(rCtx))
+    {
+      modified = true;
+
+      if (Properties::instance().getPrintIntermediateOpt())
+      {
+        std::cout << "After collection filter pushdown : " << std::endl;
+        rCtx.getRoot()->put(std::cout) << std::endl;
+      }
+    }
+  }
+
   // Mark node copy property
   if (Properties::instance().getNoCopyOptim())
   {
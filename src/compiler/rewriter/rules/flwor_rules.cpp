@@ -27,9 +27,12 @@
 #include "compiler/expression/script_exprs.h"
 #include "compiler/expression/expr_iter.h"
 #include "compiler/expression/expr.h"
+#include "compiler/expression/path_expr.h"
 
 #include "context/static_context.h"
 
+#include "zorbamisc/ns_consts.h"
+
 #include "types/typeops.h"
 #include "types/casting.h"
 
@@ -1792,5 +1795,990 @@ expr* MergeFLWOR::apply(RewriterContext& rCtx, expr* node, bool& modified)
 }
 
 
+
+/*******************************************************************************
+  Push simple predicates on the members of a collection into the store scan
+  that produces them:
+
+  for $x in dml:collection(qname) ... where $x/a/b = "v" ...
+  -->
+  for $x in op-zorba:collection-filter(dml:collection(qname), "v", a, b) ...
+  where $x/a/b = "v" ...
+
+  The filter is a store::CollectionFilter. A store may use it to avoid handing
+  out (and ref-counting) the members for which the predicate is definitely
+  false; it may still return members that do not satisfy the predicate, so the
+  where clause stays in place and keeps deciding the result (and raising any
+  errors). The pushed predicates are:
+
+  - path = "string"   (general comparison, XML child steps or JSON object keys)
+  - path eq "string"  (value comparison, JSON object keys only)
+  - exists(path), and the EBV of an XML path
+
+  where path is a sequence of child element name tests or object lookups that
+  starts at the for variable. String comparisons are pushed only if the default
+  collation is the codepoint collation.
+********************************************************************************/
+static bool is_lax_wrapper(const cast_base_expr* e, bool& singleton)
+{
+  RootTypeManager& rtm = GENV_TYPESYSTEM;
+  TypeManager* tm = e->get_type_manager();
+  xqtref_t targetType = e->get_target_type();
+
+  if (TypeOps::is_subtype(tm, *rtm.ANY_ATOMIC_TYPE_STAR, *targetType) ||
+      TypeOps::is_subtype(tm, *rtm.ANY_NODE_TYPE_STAR, *targetType))
+    return true;
+
+  if (TypeOps::is_subtype(tm, *rtm.ANY_ATOMIC_TYPE_QUESTION, *targetType))
+  {
+    singleton = true;
+    return true;
+  }
+
+  return false;
+}
+
+
+static expr* unwrap_filter_operand(expr* e, bool& singleton)
+{
+  while (true)
+  {
+    switch (e->get_expr_kind())
+    {
+    case wrapper_expr_kind:
+    {
+      e = static_cast<wrapper_expr*>(e)->get_input();
+      break;
+    }
+    case promote_expr_kind:
+    case treat_expr_kind:
+    {
+      cast_base_expr* castExpr = static_cast<cast_base_expr*>(e);
+
+      if (!is_lax_wrapper(castExpr, singleton))
+        return e;
+
+      e = castExpr->get_input();
+      break;
+    }
+    case fo_expr_kind:
+    {
+      switch (e->get_function_kind())
+      {
+      case FunctionConsts::FN_DATA_1:
+      case FunctionConsts::OP_DISTINCT_NODES_1:
+      case FunctionConsts::OP_DISTINCT_NODES_OR_ATOMICS_1:
+      case FunctionConsts::OP_SORT_NODES_ASC_1:
+      case FunctionConsts::OP_SORT_NODES_ASC_OR_ATOMICS_1:
+      case FunctionConsts::OP_SORT_DISTINCT_NODES_ASC_1:
+      case FunctionConsts::OP_SORT_DISTINCT_NODES_ASC_OR_ATOMICS_1:
+        e = static_cast<fo_expr*>(e)->get_arg(0);
+        break;
+      default:
+        return e;
+      }
+      break;
+    }
+    default:
+      return e;
+    }
+  }
+}
+
+
+/*******************************************************************************
+  If e is a path that starts at var and consists of child element name tests
+  only (xml == true) or of object lookups with constant keys only (xml ==
+  false), store its steps (in order) in the given vector and return true.
+********************************************************************************/
+static bool get_filter_path(
+    expr* e,
+    const var_expr* var,
+    std::vector<store::Item_t>& steps,
+    bool& xml)
+{
+  bool singleton = false;
+  e = unwrap_filter_operand(e, singleton);
+
+  if (e->get_expr_kind() == relpath_expr_kind)
+  {
+    relpath_expr* path = static_cast<relpath_expr*>(e);
+
+    if (path->size() < 2 ||
+        unwrap_filter_operand((*path)[0], singleton) != var)
+      return false;
+
+    for (csize i = 1; i < path->size(); ++i)
+    {
+      if ((*path)[i]->get_expr_kind() != axis_step_expr_kind)
+        return false;
+
+      axis_step_expr* step = static_cast<axis_step_expr*>((*path)[i]);
+      match_expr* test = step->getTest();
+
+      if (step->getAxis() != axis_kind_child ||
+          test->getTestKind() != match_name_test ||
+          test->getWildKind() != match_no_wild ||
+          test->getNodeKind() != store::StoreConsts::elementNode ||
+          test->getQName() == NULL)
+        return false;
+
+      steps.push_back(test->getQName());
+    }
+
+    // An XML path may select several nodes, so it can only be compared via
+    // a general comparison.
+    xml = true;
+    return !singleton;
+  }
+
+  std::vector<store::Item_t> revSteps;
+
+  while (e != var)
+  {
+    FunctionConsts::FunctionKind fkind = e->get_function_kind();
+
+    if (fkind != FunctionConsts::OP_ZORBA_SINGLE_OBJECT_LOOKUP_2 &&
+        fkind != FunctionConsts::OP_ZORBA_MULTI_OBJECT_LOOKUP_2)
+      return false;
+
+    fo_expr* lookup = static_cast<fo_expr*>(e);
+    expr* keyExpr = lookup->get_arg(1);
+
+    if (keyExpr->get_expr_kind() != const_expr_kind ||
+        static_cast<const_expr*>(keyExpr)->get_val()->getTypeCode() !=
+        store::XS_STRING)
+      return false;
+
+    revSteps.push_back(static_cast<const_expr*>(keyExpr)->get_val());
+
+    e = unwrap_filter_operand(lookup->get_arg(0), singleton);
+  }
+
+  if (revSteps.empty())
+    return false;
+
+  steps.assign(revSteps.rbegin(), revSteps.rend());
+  xml = false;
+  return true;
+}
+
+
+/*******************************************************************************
+  Check if pred is a predicate on var that can be pushed into the scan of the
+  collection that var ranges over. If so, set the filter value (NULL for an
+  existence test) and path steps.
+********************************************************************************/
+static bool get_collection_filter(
+    expr* pred,
+    const var_expr* var,
+    store::Item_t& value,
+    std::vector<store::Item_t>& steps)
+{
+  bool xml;
+
+  if (pred->get_function_kind() == FunctionConsts::FN_BOOLEAN_1)
+  {
+    expr* arg = static_cast<fo_expr*>(pred)->get_arg(0);
+
+    if (get_filter_path(arg, var, steps, xml) && xml)
+    {
+      value = NULL;
+      return true;
+    }
+
+    steps.clear();
+    pred = arg;
+  }
+
+  if (pred->get_expr_kind() != fo_expr_kind)
+    return false;
+
+  fo_expr* fo = static_cast<fo_expr*>(pred);
+  const function* func = fo->get_func();
+
+  if (func->getKind() == FunctionConsts::FN_EXISTS_1)
+  {
+    if (get_filter_path(fo->get_arg(0), var, steps, xml))
+    {
+      value = NULL;
+      return true;
+    }
+
+    return false;
+  }
+
+  CompareConsts::CompareType compKind = func->comparisonKind();
+
+  if ((compKind != CompareConsts::GENERAL_EQUAL &&
+       compKind != CompareConsts::VALUE_EQUAL) ||
+      fo->num_args() != 2)
+    return false;
+
+  static_context* sctx = fo->get_sctx();
+
+  if (sctx->get_default_collation(fo->get_loc()) != W3C_CODEPT_COLLATION_NS)
+    return false;
+
+  for (csize i = 0; i < 2; ++i)
+  {
+    bool singleton = false;
+    expr* constExpr = unwrap_filter_operand(fo->get_arg(1 - i), singleton);
+
+    if (constExpr->get_expr_kind() != const_expr_kind ||
+        static_cast<const_expr*>(constExpr)->get_val()->getTypeCode() !=
+        store::XS_STRING)
+      continue;
+
+    if (get_filter_path(fo->get_arg(i), var, steps, xml) &&
+        (!xml || compKind == CompareConsts::GENERAL_EQUAL))
+    {
+      value = static_cast<const_expr*>(constExpr)->get_val();
+      return true;
+    }
+
+    steps.clear();
+  }
+
+  return false;
+}
+
+
+RULE_REWRITE_PRE(PushCollectionFilters)
+{
+  if (node->get_expr_kind() != flwor_expr_kind)
+    return NULL;
+
+  flwor_expr* flwor = static_cast<flwor_expr*>(node);
+  csize numClauses = flwor->num_clauses();
+  bool modified = false;
+
+  for (csize i = 0; i < numClauses; ++i)
+  {
+    if (flwor->get_clause(i)->get_kind() != flwor_clause::for_clause)
+      continue;
+
+    for_clause* fc = static_cast<for_clause*>(flwor->get_clause(i));
+    expr* domExpr = fc->get_expr();
+
+    FunctionConsts::FunctionKind fkind = domExpr->get_function_kind();
+
+    if ((fkind != FunctionConsts::ZORBA_STORE_STATIC_COLLECTIONS_DML_COLLECTION_1 &&
+         fkind != FunctionConsts::ZORBA_STORE_DYNAMIC_COLLECTIONS_DML_COLLECTION_1) ||
+        fc->get_pos_var() != NULL ||
+        fc->is_allowing_empty() ||
+        static_cast<fo_expr*>(domExpr)->get_arg(0)->get_expr_kind() !=
+        const_expr_kind)
+      continue;
+
+    var_expr* var = fc->get_var();
+    store::Item_t value;
+    std::vector<store::Item_t> steps;
+    bool found = false;
+
+    for (csize j = i + 1; j < numClauses && !found; ++j)
+    {
+      const flwor_clause* c = flwor->get_clause(j);
+
+      if (c->get_kind() == flwor_clause::let_clause ||
+          c->get_kind() == flwor_clause::for_clause)
+      {
+        if (static_cast<const forlet_clause*>(c)->get_expr()->is_sequential())
+          break;
+
+        continue;
+      }
+
+      if (c->get_kind() != flwor_clause::where_clause)
+        break;
+
+      expr* whereExpr = static_cast<const where_clause*>(c)->get_expr();
+
+      if (whereExpr->get_function_kind() == FunctionConsts::OP_AND_N)
+      {
+        fo_expr* andExpr = static_cast<fo_expr*>(whereExpr);
+
+        for (csize k = 0; k < andExpr->num_args() && !found; ++k)
+          found = get_collection_filter(andExpr->get_arg(k), var, value, steps);
+      }
+      else
+      {
+        found = get_collection_filter(whereExpr, var, value, steps);
+      }
+    }
+
+    if (!found)
+      continue;
+
+    static_context* sctx = domExpr->get_sctx();
+    user_function* udf = domExpr->get_udf();
+    const QueryLoc& loc = domExpr->get_loc();
+
+    std::vector<expr*> args;
+    args.push_back(domExpr);
+
+    if (value != NULL)
+      args.push_back(rCtx.theEM->create_const_expr(sctx, udf, loc, value));
+    else
+      args.push_back(rCtx.theEM->create_seq(sctx, udf, loc));
+
+    for (csize k = 0; k < steps.size(); ++k)
+      args.push_back(rCtx.theEM->create_const_expr(sctx, udf, loc, steps[k]));
+
+    expr* filterExpr = rCtx.theEM->
+    create_fo_expr(sctx, udf, loc, BUILTIN_FUNC(OP_ZORBA_COLLECTION_FILTER_N), args);
+
+    expr_tools::fix_annotations(filterExpr, domExpr);
+
+    fc->set_expr(filterExpr);
+
+    modified = true;
+  }
+
+  return (modified ? node : NULL);
+}
+
+
+RULE_REWRITE_POST(PushCollectionFilters)
+{
+  return NULL;
+}
+
+
+/*******************************************************************************
+  An occurrence of a candidate common subexpression of a flwor expr F. The
+  occurrence is either the whole expr of a let, where, or orderby clause of F
+  (theRef == NULL) or of the return clause (theRef == NULL and theClause ==
+  NULL), or an expr nested inside such a clause expr (theRef points to the
+  slot of its parent expr that holds it).
+********************************************************************************/
+struct CseOccurrence
+{
+  expr         * theExpr;
+  expr        ** theRef;
+  flwor_clause * theClause;
+  csize          theColumn;
+  csize          thePos;
+  uint32_t       theHash;
+  csize          theSize;
+};
+
+
+/*******************************************************************************
+  Info computed bottom-up for every expr inside the clause exprs of a flwor.
+  An expr is comparable if it consists only of exprs for which cse_equal()
+  knows how to compare the expr-specific data.
+********************************************************************************/
+struct CseInfo
+{
+  bool      theComparable;
+  bool      theNavigates;
+  uint32_t  theHash;
+  csize     theSize;
+};
+
+
+static inline uint32_t cse_combine(uint32_t hash, uintptr_t v)
+{
+  return hash * 31 + static_cast<uint32_t>(v ^ (v >> 16));
+}
+
+
+/*******************************************************************************
+  Check whether e may be evaluated once and its result shared among all of its
+  (structurally equal) occurrences: e must not construct nodes (its result
+  would have a different identity per evaluation), be nondeterministic, or have
+  side effects.
+********************************************************************************/
+static bool is_cse_candidate(expr* e, const CseInfo& info)
+{
+  if (!info.theComparable || !info.theNavigates)
+    return false;
+
+  if (e->get_expr_kind() == fo_expr_kind)
+  {
+    FunctionConsts::FunctionKind fkind = e->get_function_kind();
+
+    if (fkind == FunctionConsts::OP_UNHOIST_1 ||
+        fkind == FunctionConsts::ZORBA_STORE_STATIC_COLLECTIONS_DML_COLLECTION_1 ||
+        fkind == FunctionConsts::ZORBA_STORE_DYNAMIC_COLLECTIONS_DML_COLLECTION_1)
+      return false;
+  }
+  else if (e->get_expr_kind() != relpath_expr_kind)
+  {
+    return false;
+  }
+
+  return !(e->constructsNodes() ||
+           e->is_nondeterministic() ||
+           e->is_sequential() ||
+           e->is_updating() ||
+           e->isNonDiscardable() ||
+           e->containsRecursiveCall() ||
+           e->containsPragma() ||
+           e->isUnhoistable());
+}
+
+
+/*******************************************************************************
+  Compute the CseInfo of e and, recursively, of its sub exprs, and collect the
+  candidate occurrences among them.
+********************************************************************************/
+static void collect_cse_occurrences(
+    expr* e,
+    expr** ref,
+    flwor_clause* clause,
+    csize column,
+    csize pos,
+    CseInfo& info,
+    std::vector<CseOccurrence>& occurrences)
+{
+  info.theComparable = true;
+  info.theNavigates = false;
+  info.theHash = e->get_expr_kind();
+  info.theSize = 1;
+
+  switch (e->get_expr_kind())
+  {
+  case var_expr_kind:
+  {
+    info.theHash = cse_combine(info.theHash, reinterpret_cast<uintptr_t>(e));
+    return;
+  }
+  case const_expr_kind:
+  {
+    const store::Item* val = static_cast<const_expr*>(e)->get_val();
+
+    if (!val->isAtomic())
+      info.theComparable = false;
+    else
+      info.theHash = cse_combine(info.theHash, val->getTypeCode());
+
+    return;
+  }
+  case fo_expr_kind:
+  {
+    const function* func = static_cast<fo_expr*>(e)->get_func();
+
+    if (func->getKind() == FunctionConsts::OP_HOIST_1 ||
+        func->getKind() == FunctionConsts::OP_ENCLOSED_1)
+      info.theComparable = false;
+
+    if (func->isUdf())
+      info.theNavigates = true;
+
+    info.theHash = cse_combine(info.theHash, reinterpret_cast<uintptr_t>(func));
+    break;
+  }
+  case relpath_expr_kind:
+  {
+    info.theNavigates = true;
+    break;
+  }
+  case axis_step_expr_kind:
+  {
+    info.theHash = cse_combine(info.theHash,
+                               static_cast<axis_step_expr*>(e)->getAxis());
+    break;
+  }
+  case match_expr_kind:
+  {
+    match_expr* test = static_cast<match_expr*>(e);
+    info.theHash = cse_combine(info.theHash, test->getTestKind());
+    info.theHash = cse_combine(info.theHash, test->getWildKind());
+    break;
+  }
+  case wrapper_expr_kind:
+  {
+    break;
+  }
+  case function_item_expr_kind:
+  {
+    // Do not look inside inline functions: their exprs may reference the
+    // function params.
+    info.theComparable = false;
+    return;
+  }
+  default:
+  {
+    info.theComparable = false;
+    break;
+  }
+  }
+
+  if (e->is_sequential())
+  {
+    info.theComparable = false;
+    return;
+  }
+
+  ExprIterator iter(e);
+
+  while (!iter.done())
+  {
+    expr** childRef = *iter;
+
+    if (*childRef != NULL)
+    {
+      CseInfo childInfo;
+
+      collect_cse_occurrences(*childRef, childRef, clause, column, pos,
+                              childInfo, occurrences);
+
+      info.theComparable = info.theComparable && childInfo.theComparable;
+      info.theNavigates = info.theNavigates || childInfo.theNavigates;
+      info.theHash = cse_combine(info.theHash, childInfo.theHash);
+      info.theSize += childInfo.theSize;
+    }
+
+    iter.next();
+  }
+
+  if (is_cse_candidate(e, info))
+  {
+    CseOccurrence occ;
+    occ.theExpr = e;
+    occ.theRef = ref;
+    occ.theClause = clause;
+    occ.theColumn = column;
+    occ.thePos = pos;
+    occ.theHash = info.theHash;
+    occ.theSize = info.theSize;
+    occurrences.push_back(occ);
+  }
+}
+
+
+/*******************************************************************************
+  Check whether e1 and e2, two comparable exprs, are structurally equal, i.e.,
+  they compute the same result. The node-related annotations must also be the
+  same, because they affect how the nodes in the result are produced.
+********************************************************************************/
+static bool cse_equal(expr* e1, expr* e2)
+{
+  if (e1 == e2)
+    return true;
+
+  if (e1->get_expr_kind() != e2->get_expr_kind())
+    return false;
+
+  const uint32_t nodeMask = (expr::IGNORES_SORTED_NODES_MASK |
+                             expr::IGNORES_DUPLICATE_NODES_MASK);
+
+  if ((e1->getAnnotationFlags() & nodeMask) !=
+      (e2->getAnnotationFlags() & nodeMask))
+    return false;
+
+  switch (e1->get_expr_kind())
+  {
+  case var_expr_kind:
+  {
+    return false;
+  }
+  case const_expr_kind:
+  {
+    const store::Item* v1 = static_cast<const_expr*>(e1)->get_val();
+    const store::Item* v2 = static_cast<const_expr*>(e2)->get_val();
+
+    return (v1->getTypeCode() == v2->getTypeCode() && v1->equals(v2));
+  }
+  case fo_expr_kind:
+  {
+    fo_expr* fo1 = static_cast<fo_expr*>(e1);
+    fo_expr* fo2 = static_cast<fo_expr*>(e2);
+
+    if (fo1->get_func() != fo2->get_func() ||
+        fo1->num_args() != fo2->num_args())
+      return false;
+
+    break;
+  }
+  case relpath_expr_kind:
+  {
+    if (static_cast<relpath_expr*>(e1)->size() !=
+        static_cast<relpath_expr*>(e2)->size())
+      return false;
+
+    break;
+  }
+  case axis_step_expr_kind:
+  {
+    axis_step_expr* s1 = static_cast<axis_step_expr*>(e1);
+    axis_step_expr* s2 = static_cast<axis_step_expr*>(e2);
+
+    if (s1->getAxis() != s2->getAxis() ||
+        s1->use_reverse_order() != s2->use_reverse_order())
+      return false;
+
+    break;
+  }
+  case match_expr_kind:
+  {
+    match_expr* m1 = static_cast<match_expr*>(e1);
+    match_expr* m2 = static_cast<match_expr*>(e2);
+
+    if (m1->getTestKind() != m2->getTestKind() ||
+        m1->getDocTestKind() != m2->getDocTestKind() ||
+        m1->getWildKind() != m2->getWildKind() ||
+        m1->getWildName() != m2->getWildName() ||
+        m1->getNilledAllowed() != m2->getNilledAllowed())
+      return false;
+
+    if ((m1->getQName() == NULL) != (m2->getQName() == NULL) ||
+        (m1->getQName() != NULL && !m1->getQName()->equals(m2->getQName())))
+      return false;
+
+    if ((m1->getTypeName() == NULL) != (m2->getTypeName() == NULL) ||
+        (m1->getTypeName() != NULL &&
+         !m1->getTypeName()->equals(m2->getTypeName())))
+      return false;
+
+    break;
+  }
+  case wrapper_expr_kind:
+  {
+    break;
+  }
+  default:
+  {
+    return false;
+  }
+  }
+
+  ExprIterator iter1(e1);
+  ExprIterator iter2(e2);
+
+  while (!iter1.done() && !iter2.done())
+  {
+    expr* c1 = **iter1;
+    expr* c2 = **iter2;
+
+    if (c1 == NULL || c2 == NULL)
+    {
+      if (c1 != c2)
+        return false;
+    }
+    else if (!cse_equal(c1, c2))
+    {
+      return false;
+    }
+
+    iter1.next();
+    iter2.next();
+  }
+
+  return iter1.done() && iter2.done();
+}
+
+
+/*******************************************************************************
+  Check whether all the free vars of e are in scope right before the pos-th
+  clause of the given flwor.
+********************************************************************************/
+static bool cse_in_scope(const expr* e, const flwor_expr* flwor, csize pos)
+{
+  const expr::FreeVars& vars = e->getFreeVars();
+
+  expr::FreeVars::const_iterator ite = vars.begin();
+  expr::FreeVars::const_iterator end = vars.end();
+
+  for (; ite != end; ++ite)
+  {
+    var_expr* var = *ite;
+    const flwor_clause* c = var->get_flwor_clause();
+
+    if (c == NULL)
+    {
+      if (var->get_kind() != var_expr::prolog_var &&
+          var->get_kind() != var_expr::arg_var)
+        return false;
+    }
+    else if (c->get_flwor_expr() != flwor)
+    {
+      if (flwor->getFreeVars().find(var) == flwor->getFreeVars().end())
+        return false;
+    }
+    else
+    {
+      csize i = 0;
+      while (i < pos && flwor->get_clause(i) != c)
+        ++i;
+
+      if (i == pos)
+        return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*******************************************************************************
+  Replace the given occurrence with e.
+********************************************************************************/
+static void replace_cse_occurrence(
+    flwor_expr* flwor,
+    const CseOccurrence& occ,
+    expr* e)
+{
+  if (occ.theRef != NULL)
+  {
+    *occ.theRef = e;
+  }
+  else if (occ.theClause == NULL)
+  {
+    flwor->set_return_expr(e);
+  }
+  else
+  {
+    switch (occ.theClause->get_kind())
+    {
+    case flwor_clause::let_clause:
+      static_cast<let_clause*>(occ.theClause)->set_expr(e);
+      break;
+    case flwor_clause::where_clause:
+      static_cast<where_clause*>(occ.theClause)->set_expr(e);
+      break;
+    case flwor_clause::orderby_clause:
+      static_cast<orderby_clause*>(occ.theClause)->set_column_expr(occ.theColumn, e);
+      break;
+    default:
+      ZORBA_ASSERT(false);
+    }
+  }
+}
+
+
+/*******************************************************************************
+  Collect the candidate occurrences in the let, where, orderby, and return
+  clauses of the given flwor. Group-by and materialize clauses rebind the
+  tuple stream, so only the clauses after the last such clause are
+  considered.
+********************************************************************************/
+static void collect_flwor_cse_occurrences(
+    flwor_expr* flwor,
+    std::vector<CseOccurrence>& occurrences)
+{
+  csize numClauses = flwor->num_clauses();
+  CseInfo info;
+
+  for (csize i = 0; i < numClauses; ++i)
+  {
+    flwor_clause* c = flwor->get_clause(i);
+
+    switch (c->get_kind())
+    {
+    case flwor_clause::let_clause:
+    {
+      let_clause* lc = static_cast<let_clause*>(c);
+      collect_cse_occurrences(lc->get_expr(), NULL, c, 0, i, info, occurrences);
+      break;
+    }
+    case flwor_clause::where_clause:
+    {
+      where_clause* wc = static_cast<where_clause*>(c);
+      collect_cse_occurrences(wc->get_expr(), NULL, c, 0, i, info, occurrences);
+      break;
+    }
+    case flwor_clause::orderby_clause:
+    {
+      orderby_clause* oc = static_cast<orderby_clause*>(c);
+
+      for (csize j = 0; j < oc->num_columns(); ++j)
+      {
+        collect_cse_occurrences(oc->get_column_expr(j), NULL, c, j, i,
+                                info, occurrences);
+      }
+      break;
+    }
+    case flwor_clause::groupby_clause:
+    case flwor_clause::materialize_clause:
+    {
+      occurrences.clear();
+      break;
+    }
+    default:
+      break;
+    }
+  }
+
+  collect_cse_occurrences(flwor->get_return_expr(), NULL, NULL, 0, numClauses,
+                          info, occurrences);
+}
+
+
+/*
+  The maximum number of common subexpressions eliminated from a single flwor
+  expr. Each elimination recollects and rehashes the subexprs of the whole
+  flwor, so the cap bounds the rule to a fixed number of passes over the flwor
+  for machine-generated queries with many repeated paths. Any common subexprs
+  left over are simply evaluated as before.
+*/
+static const csize MAX_CSE_PER_FLWOR = 16;
+
+
+/*******************************************************************************
+  Common subexpression elimination: a side-effect-free expr E that appears
+  more than once in the clauses of a flwor expr F, e.g. $x/a/b in the where,
+  order by, and return clauses, is computed only once per tuple, by a let
+  clause of F, and all the occurrences are replaced by references to the let
+  var. The let clause is placed right after the clause that binds the last of
+  the free vars of E, but not before any WHERE clause that precedes the first
+  occurrence. As in HoistRule, the let var is bound to op:hoist(E) and
+  referenced via op:unhoist($var), so that any error raised by E is raised only
+  if and where E was originally evaluated. If the first occurrence is the whole
+  domain expr of a let clause, the var of that clause is referenced instead.
+********************************************************************************/
+RULE_REWRITE_PRE(EliminateCommonSubexprs)
+{
+  if (node->get_expr_kind() != flwor_expr_kind || node->is_sequential())
+    return NULL;
+
+  flwor_expr* flwor = static_cast<flwor_expr*>(node);
+  bool modified = false;
+
+  // Each iteration eliminates the largest common subexpression.
+  for (csize iteration = 0; iteration < MAX_CSE_PER_FLWOR; ++iteration)
+  {
+    zorba::MarkFreeVars freeVarsRule;
+    bool dummy;
+    freeVarsRule.apply(rCtx, flwor, dummy);
+
+    std::vector<CseOccurrence> occurrences;
+    collect_flwor_cse_occurrences(flwor, occurrences);
+
+    std::vector<CseOccurrence> best;
+    csize bestSize = 0;
+
+    for (csize i = 0; i < occurrences.size(); ++i)
+    {
+      const CseOccurrence& occ = occurrences[i];
+
+      if (occ.theSize <= bestSize || occ.theExpr == NULL)
+        continue;
+
+      std::vector<CseOccurrence> group;
+      group.push_back(occ);
+
+      for (csize j = i + 1; j < occurrences.size(); ++j)
+      {
+        if (occurrences[j].theHash == occ.theHash &&
+            occurrences[j].theSize == occ.theSize &&
+            cse_equal(occ.theExpr, occurrences[j].theExpr))
+        {
+          group.push_back(occurrences[j]);
+        }
+      }
+
+      if (group.size() < 2)
+        continue;
+
+      csize pos = group[0].thePos;
+      for (csize j = 1; j < group.size(); ++j)
+      {
+        if (group[j].thePos < pos)
+          pos = group[j].thePos;
+      }
+
+      if (!cse_in_scope(occ.theExpr, flwor, pos))
+        continue;
+
+      best.swap(group);
+      bestSize = occ.theSize;
+    }
+
+    if (best.empty())
+      break;
+
+    csize pos = best[0].thePos;
+    csize first = 0;
+    for (csize j = 1; j < best.size(); ++j)
+    {
+      if (best[j].thePos < pos)
+      {
+        pos = best[j].thePos;
+        first = j;
+      }
+    }
+
+    // Move the new let clause up past the clauses that do not bind any free
+    // var of the expr, so that it is not evaluated once per tuple of an inner
+    // FOR that it does not depend on. Stop at a WHERE clause, so that the expr
+    // is not evaluated for tuples that the WHERE clause would drop.
+    csize letPos = pos;
+    while (letPos > 0)
+    {
+      flwor_clause::ClauseKind kind = flwor->get_clause(letPos-1)->get_kind();
+
+      if (kind == flwor_clause::where_clause ||
+          kind == flwor_clause::groupby_clause ||
+          kind == flwor_clause::materialize_clause ||
+          !cse_in_scope(best[first].theExpr, flwor, letPos-1))
+        break;
+
+      --letPos;
+    }
+
+    expr* e = best[first].theExpr;
+    static_context* sctx = e->get_sctx();
+    user_function* udf = e->get_udf();
+    const QueryLoc& loc = e->get_loc();
+
+    if (best[first].theRef == NULL &&
+        best[first].theClause != NULL &&
+        best[first].theClause->get_kind() == flwor_clause::let_clause)
+    {
+      var_expr* letVar = static_cast<let_clause*>(best[first].theClause)->get_var();
+
+      for (csize j = 0; j < best.size(); ++j)
+      {
+        if (j == first)
+          continue;
+
+        expr* ref = rCtx.theEM->create_wrapper_expr(sctx, udf, loc, letVar);
+        ref->setAnnotationFlags(best[j].theExpr->getAnnotationFlags());
+        replace_cse_occurrence(flwor, best[j], ref);
+      }
+    }
+    else
+    {
+      var_expr* letVar = rCtx.createTempVar(sctx, loc, var_expr::let_var);
+
+      expr* hoisted = rCtx.theEM->
+      create_fo_expr(sctx, udf, loc, BUILTIN_FUNC(OP_HOIST_1), e);
+
+      hoisted->setAnnotationFlags(e->getAnnotationFlags());
+
+      let_clause* lc = rCtx.theEM->create_let_clause(sctx, loc, letVar, hoisted);
+
+      letVar->set_flwor_clause(lc);
+
+      for (csize j = 0; j < best.size(); ++j)
+      {
+        expr* unhoisted = rCtx.theEM->
+        create_fo_expr(sctx, udf, loc,
+                       BUILTIN_FUNC(OP_UNHOIST_1),
+                       rCtx.theEM->create_wrapper_expr(sctx, udf, loc, letVar));
+
+        unhoisted->setAnnotationFlags(best[j].theExpr->getAnnotationFlags());
+        replace_cse_occurrence(flwor, best[j], unhoisted);
+      }
+
+      flwor->add_clause(letPos, lc);
+    }
+
+    modified = true;
+  }
+
+  return (modified ? node : NULL);
+}
+
+
+RULE_REWRITE_POST(EliminateCommonSubexprs)
+{
+  return NULL;
+}
+
+
 }
 /* vim:set et sw=2 ts=2: */
@@ -424,6 +424,20 @@ bool IndexJoinRule::isIndexJoinPredicate(PredicateInfo& predInfo)
   if (predInfo.theInnerVar->get_kind() != var_expr::for_var)
     return false;
 
+  // The outer operand becomes the probe key in the domain expr of the inner
+  // var, so it must not reference any var defined after the inner var, e.g.
+  // a LET var that is defined between the inner FOR and the WHERE clause.
+  // (findLoopVar() sees through such a LET var to the outer var.)
+  const DynamicBitset& outerOpVars = (*theExprVarsMap)[predInfo.theOuterOp];
+
+  for (csize varid = predInfo.theInnerVarId + 1;
+       varid < outerOpVars.size();
+       ++varid)
+  {
+    if (outerOpVars.get(varid))
+      return false;
+  }
+
   if (predInfo.theInnerVar->get_flwor_clause() ==
       predInfo.theOuterVar->get_flwor_clause())
     return false;
@@ -545,7 +559,83 @@ bool IndexJoinRule::isIndexJoinPredicate(PredicateInfo& predInfo)
       return false;
   }
 
-  return true;
+  return isHashJoinCheaper(predInfo);
+}
+
+
+/*******************************************************************************
+  Cost check for the hashjoin rewrite. Let M be the number of items in the
+  domain of the inner var and N the number of tuples that reach the inner var
+  clause each time the index is (re)built. The nested-loop join then costs
+  about N*M comparisons, whereas the hashjoin costs the creation of the temp
+  index plus M insertions and N probes.
+
+  The rewrite is rejected only if both N and M can be estimated (see
+  expr_tools::estimate_cardinality()) and the nested loop comes out cheaper.
+  Both are estimated only when the index is built inside the flwor that
+  defines the inner var, and the outer var is defined in that flwor too.
+********************************************************************************/
+static const double INDEX_CREATE_COST = 64;
+static const double INDEX_INSERT_COST = 4;
+static const double INDEX_PROBE_COST = 2;
+
+bool IndexJoinRule::isHashJoinCheaper(const PredicateInfo& predInfo)
+{
+  flwor_expr* flwor = predInfo.theFlworExpr;
+
+  if (predInfo.theStackPos >= theVarDefExprs.size() ||
+      theVarDefExprs[predInfo.theStackPos] != flwor ||
+      !flwor->defines_var(predInfo.theOuterVar))
+    return true;
+
+  csize innerVarPos;
+  bool found = flwor->get_var_pos(predInfo.theInnerVar, innerVarPos);
+  ZORBA_ASSERT(found);
+
+  double numTuples = 1;
+
+  for (csize i = predInfo.theChildPos; i < innerVarPos; ++i)
+  {
+    flwor_clause* c = flwor->get_clause(i);
+
+    switch (c->get_kind())
+    {
+    case flwor_clause::for_clause:
+    {
+      double card;
+      if (!expr_tools::estimate_cardinality(
+              static_cast<for_clause*>(c)->get_expr(), card))
+        return true;
+
+      numTuples *= card;
+      break;
+    }
+    case flwor_clause::let_clause:
+    case flwor_clause::where_clause:
+    case flwor_clause::orderby_clause:
+    case flwor_clause::groupby_clause:
+    {
+      break;
+    }
+    default:
+    {
+      return true;
+    }
+    }
+  }
+
+  double innerCard;
+  if (!expr_tools::estimate_cardinality(
+          predInfo.theInnerVar->get_forlet_clause()->get_expr(), innerCard))
+    return true;
+
+  double nestedLoopCost = numTuples * innerCard;
+
+  double hashJoinCost = INDEX_CREATE_COST +
+                        innerCard * INDEX_INSERT_COST +
+                        numTuples * INDEX_PROBE_COST;
+
+  return hashJoinCost <= nestedLoopCost;
 }
 
 
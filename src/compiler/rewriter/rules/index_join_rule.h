@@ -84,6 +84,8 @@ protected:
 
   bool findIndexPos(PredicateInfo& predInfo, csize boundVarId);
 
+  bool isHashJoinCheaper(const PredicateInfo& predInfo);
+
   void rewriteJoin(PredicateInfo& predInfo);
 
   void expandVars(expr* idxExpr, csize outerVarId, csize innerVarId);
@@ -52,6 +52,8 @@ public:
     MarkFreeVars,
     HoistExprsOutOfLoops,
     IndexJoin,
+    PushCollectionFilters,
+    EliminateCommonSubexprs,
     InlineFunctions,
     PartialEval,
     EchoNodes,
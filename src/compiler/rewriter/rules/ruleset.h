@@ -49,6 +49,10 @@ PREPOST_RULE(InlineFunctions);
 
 PREPOST_RULE(PartialEval);
 
+PREPOST_RULE(PushCollectionFilters);
+
+PREPOST_RULE(EliminateCommonSubexprs);
+
 
 /*******************************************************************************
 
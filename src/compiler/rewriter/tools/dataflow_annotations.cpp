@@ -559,6 +559,7 @@ void DataflowAnnotationsComputer::compute_relpath_expr(relpath_expr* e)
   {
     csize num_steps = e->size();
     bool only_child_axes = true;
+    bool only_desc_axes = true;
     ulong num_desc_axes = 0;
     ulong num_following_axes = 0;
     bool reverse_axes = false;
@@ -575,6 +576,9 @@ void DataflowAnnotationsComputer::compute_relpath_expr(relpath_expr* e)
       if (axis == axis_kind_descendant || axis == axis_kind_descendant_or_self)
         num_desc_axes++;
 
+      if (axis != axis_kind_descendant)
+        only_desc_axes = false;
+
       if (axis == axis_kind_following || axis == axis_kind_following_sibling)
         num_following_axes++;
 
@@ -618,6 +622,12 @@ void DataflowAnnotationsComputer::compute_relpath_expr(relpath_expr* e)
           sorted = true;
           distinct = true;
         }
+        else if (only_desc_axes)
+        {
+          // The steps are fused into a DescendantPathIterator during codegen.
+          sorted = true;
+          distinct = true;
+        }
         else
         {
           if (reverse_axes == false &&
@@ -30,6 +30,12 @@
 
 #include "types/typeops.h"
 
+#include "store/api/store.h"
+#include "store/api/collection.h"
+
+#include "zorbatypes/float.h"
+#include "zorbatypes/integer.h"
+
 #include <iterator>
 
 namespace zorba
@@ -916,6 +922,155 @@ int estimate_expression_size(expr* root, int limit)
 }
 
 
+/*******************************************************************************
+  Estimates the number of items returned by the given expr. The estimate is an
+  upper bound taken from the static type of the expr when that allows at most
+  one item; otherwise it is computed from the values of constant exprs and
+  ranges, from the number of members currently in the collections scanned by
+  the collection functions, and from the branches of if exprs, looking through
+  var references, let vars, treat and promote exprs, and the hoist/unhoist
+  wrappers added by the HoistRule. Returns false if no estimate can be made.
+
+  Note: a collection size is the size at compile time, so a plan that is reused
+  after the collection has grown may use a nested loop where an index would be
+  cheaper. An empty collection gives no estimate: it is most likely filled by
+  the query itself, or by the program that compiled it, before it is scanned.
+********************************************************************************/
+bool estimate_cardinality(expr* e, double& card)
+{
+  xqtref_t type = e->get_return_type();
+
+  if (type->is_empty())
+  {
+    card = 0;
+    return true;
+  }
+
+  SequenceType::Quantifier quant = type->get_quantifier();
+
+  if (quant == SequenceType::QUANT_ONE || quant == SequenceType::QUANT_QUESTION)
+  {
+    card = 1;
+    return true;
+  }
+
+  switch (e->get_expr_kind())
+  {
+  case var_expr_kind:
+  {
+    var_expr* var = static_cast<var_expr*>(e);
+
+    if (var->get_kind() == var_expr::let_var)
+      return estimate_cardinality(var->get_domain_expr(), card);
+
+    return false;
+  }
+  case wrapper_expr_kind:
+  {
+    return estimate_cardinality(static_cast<wrapper_expr*>(e)->get_input(), card);
+  }
+  case treat_expr_kind:
+  case promote_expr_kind:
+  {
+    return estimate_cardinality(static_cast<cast_base_expr*>(e)->get_input(), card);
+  }
+  case if_expr_kind:
+  {
+    if_expr* ifExpr = static_cast<if_expr*>(e);
+
+    double thenCard;
+    double elseCard;
+    if (!estimate_cardinality(ifExpr->get_then_expr(), thenCard) ||
+        !estimate_cardinality(ifExpr->get_else_expr(), elseCard))
+      return false;
+
+    card = (thenCard > elseCard ? thenCard : elseCard);
+    return true;
+  }
+  case fo_expr_kind:
+  {
+    fo_expr* fo = static_cast<fo_expr*>(e);
+
+    switch (fo->get_func()->getKind())
+    {
+    case FunctionConsts::OP_HOIST_1:
+    case FunctionConsts::OP_UNHOIST_1:
+    {
+      return estimate_cardinality(fo->get_arg(0), card);
+    }
+    case FunctionConsts::OP_CONCATENATE_N:
+    {
+      card = 0;
+
+      csize numArgs = fo->num_args();
+      for (csize i = 0; i < numArgs; ++i)
+      {
+        double argCard;
+        if (!estimate_cardinality(fo->get_arg(i), argCard))
+          return false;
+
+        card += argCard;
+      }
+
+      return true;
+    }
+    case FunctionConsts::OP_TO_2:
+    {
+      const expr* lo = fo->get_arg(0);
+      const expr* hi = fo->get_arg(1);
+
+      if (lo->get_expr_kind() != const_expr_kind ||
+          hi->get_expr_kind() != const_expr_kind)
+        return false;
+
+      const store::Item* loItem = static_cast<const const_expr*>(lo)->get_val();
+      const store::Item* hiItem = static_cast<const const_expr*>(hi)->get_val();
+
+      if (!TypeOps::is_subtype(loItem->getTypeCode(), store::XS_INTEGER) ||
+          !TypeOps::is_subtype(hiItem->getTypeCode(), store::XS_INTEGER))
+        return false;
+
+      card = xs_double(hiItem->getIntegerValue() - loItem->getIntegerValue())
+             .getNumber() + 1;
+
+      if (card < 0)
+        card = 0;
+
+      return true;
+    }
+    case FunctionConsts::ZORBA_STORE_STATIC_COLLECTIONS_DML_COLLECTION_1:
+    case FunctionConsts::ZORBA_STORE_DYNAMIC_COLLECTIONS_DML_COLLECTION_1:
+    {
+      const store::Item* name = fo->get_arg(0)->getQName();
+
+      if (name == NULL)
+        return false;
+
+      bool isDynamic = (fo->get_func()->getKind() ==
+        FunctionConsts::ZORBA_STORE_DYNAMIC_COLLECTIONS_DML_COLLECTION_1);
+
+      store::Collection_t coll = GENV_STORE.getCollection(name, isDynamic);
+
+      if (coll == NULL)
+        return false;
+
+      card = xs_double(coll->size()).getNumber();
+      return card > 0;
+    }
+    default:
+    {
+      return false;
+    }
+    }
+  }
+  default:
+  {
+    return false;
+  }
+  }
+}
+
+
 /*******************************************************************************
   copy annotations when wrapping an expression in a new one
 ********************************************************************************/
@@ -52,6 +52,8 @@ int count_variable_uses(expr* root, var_expr* v, int limit, std::vector<expr**>*
 
 int estimate_expression_size(expr* root, int limit);
 
+bool estimate_cardinality(expr* e, double& card);
+
 
 /*******************************************************************************
 
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "stdafx.h"
+
+#include "functions/func_collection_filter.h"
+#include "functions/function_impl.h"
+
+#include "compiler/expression/expr.h"
+#include "compiler/expression/fo_expr.h"
+
+#include "runtime/collections/collections.h"
+
+namespace zorba 
+{
+
+
+/*******************************************************************************
+  op-zorba:collection-filter($collection as item()*,
+                             $value as xs:anyAtomicType*,
+                             $step as xs:anyAtomicType*, ...)
+
+  Created by the PushCollectionFilters rule to annotate a (static or dynamic)
+  collection scan with a store::CollectionFilter: $collection is the
+  collection() call, $value is a string constant (or the empty sequence for an
+  existence test), and each $step is an xs:QName or xs:string constant. The
+  function returns its first argument; its codegen merely passes the filter on
+  to the ZorbaCollectionIterator.
+********************************************************************************/
+class zop_collection_filter : public function 
+{
+public:
+  zop_collection_filter(const signature& sig)
+    :
+    function(sig, FunctionConsts::OP_ZORBA_COLLECTION_FILTER_N)
+  {
+  }
+
+  xqtref_t getReturnType(const fo_expr* caller) const
+  {
+    return caller->get_arg(0)->get_return_type();
+  }
+
+  bool mustCopyInputNodes(expr* fo, csize input) const
+  {
+    return false;
+  }
+
+  bool propagatesInputNodes(expr* fo, csize input) const
+  {
+    return input == 0;
+  }
+
+  bool propagatesSortedNodes(csize producer) const
+  {
+    return producer == 0;
+  }
+
+  bool propagatesDistinctNodes(csize producer) const
+  {
+    return producer == 0;
+  }
+
+  CODEGEN_DECL();
+};
+
+
+PlanIter_t zop_collection_filter::codegen(
+    CompilerCB* cb,
+    static_context* sctx,
+    const QueryLoc& loc,
+    std::vector<PlanIter_t>& argv,
+    expr& ann) const
+{
+  ZorbaCollectionIterator* collIter =
+    dynamic_cast<ZorbaCollectionIterator*>(argv[0].getp());
+
+  if (collIter == NULL)
+    return argv[0];
+
+  fo_expr& fo = static_cast<fo_expr&>(ann);
+
+  std::vector<store::Item_t> path;
+
+  for (csize i = 2; i < fo.num_args(); ++i)
+  {
+    assert(fo.get_arg(i)->get_expr_kind() == const_expr_kind);
+    path.push_back(static_cast<const_expr*>(fo.get_arg(i))->get_val());
+  }
+
+  if (fo.get_arg(1)->get_expr_kind() == const_expr_kind)
+  {
+    collIter->setFilterHasValue(true);
+    collIter->setFilterValue(
+        static_cast<const_expr*>(fo.get_arg(1))->get_val()->getString());
+  }
+
+  collIter->setFilterPath(path);
+
+  return argv[0];
+}
+
+
+void populateContext_CollectionFilter(static_context* sctx)
+{
+  const char* zorba_op_ns = static_context::ZORBA_OP_NS;
+
+  DECL(sctx, zop_collection_filter,
+       (createQName(zorba_op_ns, "", "collection-filter"),
+        GENV_TYPESYSTEM.ITEM_TYPE_STAR,
+        GENV_TYPESYSTEM.ANY_ATOMIC_TYPE_STAR,
+        true,
+        GENV_TYPESYSTEM.ITEM_TYPE_STAR));
+}
+
+
+}
+/* vim:set et sw=2 ts=2: */
@@ -235,6 +235,8 @@ typedef enum
   OP_HOIST_1,
   OP_UNHOIST_1,
 
+  OP_ZORBA_COLLECTION_FILTER_N,
+
   JN_OBJECT_1,
 
 #include "functions/function_enum.h"
@@ -31,6 +31,7 @@
 #include "functions/func_base64.h"
 #include "functions/func_booleans.h"
 #include "functions/func_booleans_impl.h"
+#include "functions/func_collection_filter.h"
 #include "functions/func_collections.h"
 #include "functions/func_context.h"
 #include "functions/func_csv.h"
@@ -167,6 +168,7 @@ void BuiltinFunctionLibrary::populate(static_context* sctx)
   populateContext_Constructors(sctx);
   populateContext_VarDecl(sctx);
   populateContext_Hoisting(sctx);
+  populateContext_CollectionFilter(sctx);
   populate_context_eval(sctx);
   populate_context_reflection(sctx);
   populate_context_apply(sctx);
@@ -93,6 +93,16 @@ PlanIter_t zorba_store_indexes_static_ddl_available_indexes::codegen(
   return new AvailableIndexesIterator(sctx, loc, argv);
 }
 
+PlanIter_t zorba_store_indexes_static_ddl_index_recommendations::codegen(
+  CompilerCB*,
+  static_context* sctx,
+  const QueryLoc& loc,
+  std::vector<PlanIter_t>& argv,
+  expr& ann) const
+{
+  return new IndexRecommendationsIterator(sctx, loc, argv);
+}
+
 PlanIter_t zorba_store_static_integrity_constraints_ddl_is_activated_integrity_constraint::codegen(
   CompilerCB*,
   static_context* sctx,
@@ -895,6 +905,17 @@ void populate_context_collections(static_context* sctx)
 
 
 
+      {
+    DECL_WITH_KIND(sctx, zorba_store_indexes_static_ddl_index_recommendations,
+        (createQName("http://zorba.io/modules/store/static/indexes/ddl","","index-recommendations"), 
+        GENV_TYPESYSTEM.JSON_OBJECT_TYPE_STAR),
+        FunctionConsts::ZORBA_STORE_INDEXES_STATIC_DDL_INDEX_RECOMMENDATIONS_0);
+
+  }
+
+
+
+
       {
     DECL_WITH_KIND(sctx, zorba_store_static_integrity_constraints_ddl_is_activated_integrity_constraint,
         (createQName("http://zorba.io/modules/store/static/integrity-constraints/ddl","","is-activated-integrity-constraint"), 
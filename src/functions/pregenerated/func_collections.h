@@ -586,6 +586,23 @@ public:
 };
 
 
+//zorba-store-indexes-static-ddl:index-recommendations
+class zorba_store_indexes_static_ddl_index_recommendations : public function
+{
+public:
+  zorba_store_indexes_static_ddl_index_recommendations(const signature& sig, FunctionConsts::FunctionKind kind)
+    : 
+    function(sig, kind)
+  {
+
+  }
+
+  bool accessesDynCtx() const { return true; }
+
+  CODEGEN_DECL();
+};
+
+
 //zorba-store-static-integrity-constraints-ddl:is-activated-integrity-constraint
 class zorba_store_static_integrity_constraints_ddl_is_activated_integrity_constraint : public function
 {
@@ -98,6 +98,7 @@
   ZORBA_STORE_DYNAMIC_COLLECTIONS_DML_TRUNCATE_1,
   ZORBA_STORE_INDEXES_STATIC_DDL_IS_AVAILABLE_INDEX_1,
   ZORBA_STORE_INDEXES_STATIC_DDL_AVAILABLE_INDEXES_0,
+  ZORBA_STORE_INDEXES_STATIC_DDL_INDEX_RECOMMENDATIONS_0,
   ZORBA_STORE_STATIC_INTEGRITY_CONSTRAINTS_DDL_IS_ACTIVATED_INTEGRITY_CONSTRAINT_1,
   ZORBA_STORE_STATIC_INTEGRITY_CONSTRAINTS_DDL_ACTIVATED_INTEGRITY_CONSTRAINTS_0,
   ZORBA_STORE_STATIC_COLLECTIONS_DDL_IS_DECLARED_COLLECTION_1,
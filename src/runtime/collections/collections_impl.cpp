@@ -24,6 +24,8 @@
 
 #include "zorbatypes/URI.h"
 #include "zorbatypes/numconversions.h"
+#include "zorbatypes/float.h"
+#include "zorbatypes/integer.h"
 
 #include "system/globalenv.h"
 
@@ -273,8 +275,8 @@ void ZorbaCollectionIteratorState::reset(PlanState& planState)
 bool ZorbaCollectionIterator::isCountOptimizable() const
 {
   // if ref is passed to the collections function, count cannot be 
-  // optimized anymore.
-  return theChildren.size() <= 2;
+  // optimized anymore. Neither can it if the store filters the collection.
+  return theChildren.size() <= 2 && theFilterPath.empty();
 }
 
 
@@ -290,7 +292,14 @@ void ZorbaCollectionIterator::initCollection(PlanState& planState, int64_t skipC
 
   (void)getCollection(theSctx, name, loc, theIsDynamic, collection);
 
-  if (theChildren.size() == 1)
+  if (theChildren.size() == 1 && !theFilterPath.empty() && skipCount <= 0)
+  {
+    state->theFilter.thePath = theFilterPath;
+    state->theFilter.theHasValue = theFilterHasValue;
+    state->theFilter.theValue = theFilterValue;
+    state->theIterator = collection->getFilteredIterator(state->theFilter);
+  }
+  else if (theChildren.size() == 1)
   {
     if (skipCount < 0)
       skipCount = 0;
@@ -384,6 +393,10 @@ bool ZorbaCollectionIterator::nextImpl(
 
 bool ZorbaCollectionIterator::skipImpl(int64_t count, PlanState& planState) const
 {  
+  // positions are not known in advance if the store filters the collection
+  if (!theFilterPath.empty())
+    return PlanIterator::skipImpl(count, planState);
+
   ZorbaCollectionIteratorState* state = StateTraitsImpl<ZorbaCollectionIteratorState>::getState(planState, theStateOffset);
 
   if (state->theIterator.getp() != NULL && state->theIteratorOpened == false)
@@ -2168,6 +2181,187 @@ AvailableIndexesIterator::nextImpl(store::Item_t& result, PlanState& planState)
 }
 
 
+/*******************************************************************************
+  iddl:index-recommendations() as object()*
+
+  Returns one object per predicate that the store has evaluated while scanning
+  a collection (see store::CollectionFilterStats). An equality predicate is
+  recommended for indexing if it has been evaluated by several scans and the
+  store has kept few of the members tested. Element names in the reported path
+  are in Clark notation ({uri}local).
+********************************************************************************/
+static const uint64_t RECOMMEND_MIN_SCANS = 2;
+
+static const double RECOMMEND_MAX_SELECTIVITY = 0.1;
+
+
+static void createIndexRecommendation(
+    store::Item_t& result,
+    const store::Item* collName,
+    bool isDynamic,
+    const store::CollectionFilterStats& stats)
+{
+  std::vector<store::Item_t> names;
+  std::vector<store::Item_t> values;
+  store::Item_t item;
+  zstring str;
+
+  double selectivity = (stats.theScanned == 0 ? 1.0 :
+                        static_cast<double>(stats.theSelected) /
+                        static_cast<double>(stats.theScanned));
+
+  str = "collection";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  str = collName->getStringValue();
+  GENV_ITEMFACTORY->createString(item, str);
+  values.push_back(item);
+
+  str = "dynamic";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  GENV_ITEMFACTORY->createBoolean(item, isDynamic);
+  values.push_back(item);
+
+  str = "path";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  str.clear();
+  for (csize i = 0; i < stats.theFilter.thePath.size(); ++i)
+  {
+    const store::Item* step = stats.theFilter.thePath[i].getp();
+
+    if (step->getTypeCode() == store::XS_QNAME)
+    {
+      // Use the Clark notation so that the path does not depend on prefixes.
+      if (i > 0)
+        str += '/';
+      if (!step->getNamespace().empty())
+      {
+        str += '{';
+        str += step->getNamespace();
+        str += '}';
+      }
+      str += step->getLocalName();
+    }
+    else
+    {
+      str += '.';
+      str += step->getString();
+    }
+  }
+  GENV_ITEMFACTORY->createString(item, str);
+  values.push_back(item);
+
+  str = "kind";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  str = (stats.theFilter.theHasValue ? "equality" : "existence");
+  GENV_ITEMFACTORY->createString(item, str);
+  values.push_back(item);
+
+  str = "scans";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  GENV_ITEMFACTORY->createInteger(item, xs_integer(
+                                  static_cast<unsigned long long>(stats.theScans)));
+  values.push_back(item);
+
+  str = "scanned";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  GENV_ITEMFACTORY->createInteger(item, xs_integer(
+                                  static_cast<unsigned long long>(stats.theScanned)));
+  values.push_back(item);
+
+  str = "selected";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  GENV_ITEMFACTORY->createInteger(item, xs_integer(
+                                  static_cast<unsigned long long>(stats.theSelected)));
+  values.push_back(item);
+
+  str = "selectivity";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  GENV_ITEMFACTORY->createDouble(item, xs_double(selectivity));
+  values.push_back(item);
+
+  str = "recommended";
+  GENV_ITEMFACTORY->createString(item, str);
+  names.push_back(item);
+  GENV_ITEMFACTORY->createBoolean(item,
+                                  stats.theFilter.theHasValue &&
+                                  stats.theScans >= RECOMMEND_MIN_SCANS &&
+                                  selectivity <= RECOMMEND_MAX_SELECTIVITY);
+  values.push_back(item);
+
+  GENV_ITEMFACTORY->createJSONObject(result, names, values);
+}
+
+
+void
+IndexRecommendationsIteratorState::reset(PlanState& planState)
+{
+  PlanIteratorState::reset(planState);
+  theRecommendations.clear();
+}
+
+
+bool
+IndexRecommendationsIterator::nextImpl(
+    store::Item_t& result,
+    PlanState& planState) const
+{
+  store::Iterator_t nameIte;
+  store::Item_t name;
+  store::Collection_t collection;
+  std::vector<store::CollectionFilterStats> stats;
+
+  IndexRecommendationsIteratorState* state;
+  DEFAULT_STACK_INIT(IndexRecommendationsIteratorState, state, planState);
+
+  for (int dyn = 0; dyn < 2; ++dyn)
+  {
+    bool isDynamic = (dyn == 1);
+
+    nameIte = GENV_STORE.listCollectionNames(isDynamic);
+    nameIte->open();
+
+    while (nameIte->next(name))
+    {
+      collection = GENV_STORE.getCollection(name, isDynamic);
+
+      if (collection == NULL)
+        continue;
+
+      collection->getFilterStats(stats);
+
+      for (csize i = 0; i < stats.size(); ++i)
+      {
+        store::Item_t rec;
+        createIndexRecommendation(rec, name, isDynamic, stats[i]);
+        state->theRecommendations.push_back(rec);
+      }
+    }
+
+    nameIte->close();
+  }
+
+  for (state->thePosition = 0;
+       state->thePosition < state->theRecommendations.size();
+       ++state->thePosition)
+  {
+    result = state->theRecommendations[state->thePosition];
+    STACK_PUSH(true, state);
+  }
+
+  state->theRecommendations.clear();
+
+  STACK_END(state);
+}
+
+
 /*******************************************************************************
 
 *******************************************************************************/
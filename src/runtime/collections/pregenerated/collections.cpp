@@ -230,6 +230,9 @@ void ZorbaCollectionIterator::serialize(::zorba::serialization::Archiver& ar)
   (NaryBaseIterator<ZorbaCollectionIterator, ZorbaCollectionIteratorState>*)this);
 
     ar & theIsDynamic;
+    ar & theFilterPath;
+    ar & theFilterHasValue;
+    ar & theFilterValue;
 }
 
 
@@ -952,6 +955,49 @@ zstring AvailableIndexesIterator::getNameAsString() const {
 // </AvailableIndexesIterator>
 
 
+// <IndexRecommendationsIterator>
+SERIALIZABLE_CLASS_VERSIONS(IndexRecommendationsIterator)
+
+void IndexRecommendationsIterator::serialize(::zorba::serialization::Archiver& ar)
+{
+  serialize_baseclass(ar,
+  (NaryBaseIterator<IndexRecommendationsIterator, IndexRecommendationsIteratorState>*)this);
+}
+
+
+void IndexRecommendationsIterator::accept(PlanIterVisitor& v) const
+{
+  if (!v.hasToVisit(this))
+    return;
+
+  v.beginVisit(*this);
+
+  std::vector<PlanIter_t>::const_iterator lIter = theChildren.begin();
+  std::vector<PlanIter_t>::const_iterator lEnd = theChildren.end();
+  for ( ; lIter != lEnd; ++lIter ){
+    (*lIter)->accept(v);
+  }
+
+  v.endVisit(*this);
+}
+
+IndexRecommendationsIterator::~IndexRecommendationsIterator() {}
+
+IndexRecommendationsIteratorState::IndexRecommendationsIteratorState() {}
+
+IndexRecommendationsIteratorState::~IndexRecommendationsIteratorState() {}
+
+
+void IndexRecommendationsIteratorState::init(PlanState& planState) {
+  PlanIteratorState::init(planState);
+}
+
+zstring IndexRecommendationsIterator::getNameAsString() const {
+  return "zorba-store-indexes-static-ddl:index-recommendations";
+}
+// </IndexRecommendationsIterator>
+
+
 // <IsActivatedICIterator>
 SERIALIZABLE_CLASS_VERSIONS(IsActivatedICIterator)
 
@@ -252,6 +252,7 @@ class ZorbaCollectionIteratorState : public PlanIteratorState
 public:
   store::Iterator_t theIterator; //
   bool theIteratorOpened; //
+  store::CollectionFilter theFilter; //
 
   ZorbaCollectionIteratorState();
 
@@ -265,6 +266,9 @@ class ZorbaCollectionIterator : public NaryBaseIterator<ZorbaCollectionIterator,
 { 
 protected:
   bool theIsDynamic; //
+  std::vector<store::Item_t> theFilterPath; //
+  bool theFilterHasValue; //
+  zstring theFilterValue; //
 public:
   SERIALIZABLE_CLASS(ZorbaCollectionIterator);
 
@@ -277,16 +281,34 @@ public:
     static_context* sctx,
     const QueryLoc& loc,
     std::vector<PlanIter_t>& children,
-    bool isDynamic)
+    bool isDynamic,
+    std::vector<store::Item_t> filterPath = std::vector<store::Item_t>(),
+    bool filterHasValue = false,
+    zstring filterValue = zstring())
     : 
     NaryBaseIterator<ZorbaCollectionIterator, ZorbaCollectionIteratorState>(sctx, loc, children),
-    theIsDynamic(isDynamic)
+    theIsDynamic(isDynamic),
+    theFilterPath(filterPath),
+    theFilterHasValue(filterHasValue),
+    theFilterValue(filterValue)
   {}
 
   virtual ~ZorbaCollectionIterator();
 
   bool isDynamic() const { return theIsDynamic; }
 
+  std::vector<store::Item_t> getFilterPath() const { return theFilterPath; }
+
+  bool filterHasValue() const { return theFilterHasValue; }
+
+  zstring getFilterValue() const { return theFilterValue; }
+
+  void setFilterPath(std::vector<store::Item_t> aValue) { theFilterPath= aValue; }
+
+  void setFilterHasValue(bool aValue) { theFilterHasValue= aValue; }
+
+  void setFilterValue(zstring aValue) { theFilterValue= aValue; }
+
   zstring getNameAsString() const;
 
 public:
@@ -1071,6 +1093,52 @@ public:
 };
 
 
+/**
+ * 
+ * Author: 
+ */
+class IndexRecommendationsIteratorState : public PlanIteratorState
+{
+public:
+  std::vector<store::Item_t> theRecommendations; //
+  csize thePosition; //
+
+  IndexRecommendationsIteratorState();
+
+  ~IndexRecommendationsIteratorState();
+
+  void init(PlanState&);
+  void reset(PlanState&);
+};
+
+class IndexRecommendationsIterator : public NaryBaseIterator<IndexRecommendationsIterator, IndexRecommendationsIteratorState>
+{ 
+public:
+  SERIALIZABLE_CLASS(IndexRecommendationsIterator);
+
+  SERIALIZABLE_CLASS_CONSTRUCTOR2T(IndexRecommendationsIterator,
+    NaryBaseIterator<IndexRecommendationsIterator, IndexRecommendationsIteratorState>);
+
+  void serialize( ::zorba::serialization::Archiver& ar);
+
+  IndexRecommendationsIterator(
+    static_context* sctx,
+    const QueryLoc& loc,
+    std::vector<PlanIter_t>& children)
+    : 
+    NaryBaseIterator<IndexRecommendationsIterator, IndexRecommendationsIteratorState>(sctx, loc, children)
+  {}
+
+  virtual ~IndexRecommendationsIterator();
+
+  zstring getNameAsString() const;
+
+  void accept(PlanIterVisitor& v) const;
+
+  bool nextImpl(store::Item_t& result, PlanState& aPlanState) const;
+};
+
+
 /**
  * 
  * Author: 
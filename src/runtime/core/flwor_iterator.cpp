@@ -994,6 +994,8 @@ bool FLWORIterator::nextImpl(store::Item_t& result, PlanState& planState) const
                                  theSctx->get_typemanager(),
                                  &theMaterializeClause->theOrderSpecs);
 
+                cmp.computeSortKeys(state->theSortTable);
+
                 if (theMaterializeClause->theStable)
                 {
                   std::stable_sort(state->theSortTable.begin(),
@@ -1070,6 +1072,8 @@ bool FLWORIterator::nextImpl(store::Item_t& result, PlanState& planState) const
                                theSctx->get_typemanager(),
                                &theOrderByClause->theOrderSpecs);
 
+              cmp.computeSortKeys(state->theSortTable);
+
               if (theOrderByClause->theStable)
               {
                 std::stable_sort(state->theSortTable.begin(),
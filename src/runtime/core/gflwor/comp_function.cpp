@@ -17,12 +17,76 @@
 
 #include "runtime/core/gflwor/comp_function.h"
 
+#include <cstring>
 #include <iostream>
 
+#include "types/typeops.h"
+#include "util/utf8_util.h"
+
 namespace zorba {
 namespace flwor {
 
 
+/*******************************************************************************
+  Compare two (non-empty) collation sort keys byte-wise.
+********************************************************************************/
+static long compareSortKeys(const zstring& key1, const zstring& key2)
+{
+  csize len1 = key1.size();
+  csize len2 = key2.size();
+
+  int result = ::memcmp(key1.data(), key2.data(), len1 < len2 ? len1 : len2);
+
+  if (result != 0)
+    return (result < 0 ? -1 : 1);
+
+  return (len1 < len2 ? -1 : (len1 > len2 ? 1 : 0));
+}
+
+
+/*******************************************************************************
+  Only the values of type xs:string (or subtype) and xs:untypedAtomic get a
+  sort key: comparing two such values with a collation is comparing their
+  string values with it, both in Item::compare() and in
+  CompareIterator::valueCompare(). Any other pair of values is still compared
+  by compare().
+********************************************************************************/
+void SortTupleCmp::computeSortKeys(std::vector<SortTuple>& sortTable) const
+{
+  csize numSpecs = theOrderSpecs->size();
+
+  for (csize i = 0; i < numSpecs; ++i)
+  {
+    const XQPCollator* collator = (*theOrderSpecs)[i].theCollator;
+
+    if (collator == NULL || collator->doMemCmp())
+      continue;
+
+    std::vector<SortTuple>::iterator ite = sortTable.begin();
+    std::vector<SortTuple>::iterator end = sortTable.end();
+
+    for (; ite != end; ++ite)
+    {
+      store::Item* item = ite->theKeyValues[i];
+
+      if (item == NULL || !item->isAtomic() || item->isStreamable())
+        continue;
+
+      store::SchemaTypeCode typeCode = item->getTypeCode();
+
+      if (typeCode != store::XS_UNTYPED_ATOMIC &&
+          !TypeOps::is_subtype(typeCode, store::XS_STRING))
+        continue;
+
+      if (ite->theSortKeys.empty())
+        ite->theSortKeys.resize(numSpecs);
+
+      utf8::sort_key(item->getString(), collator, &ite->theSortKeys[i]);
+    }
+  }
+}
+
+
 bool SortTupleCmp::operator()(const SortTuple& t1, const SortTuple& t2) const
 {
   ZORBA_ASSERT(t1.theKeyValues.size() == t2.theKeyValues.size());
@@ -34,14 +98,30 @@ bool SortTupleCmp::operator()(const SortTuple& t1, const SortTuple& t2) const
 
   std::vector<OrderSpec>::const_iterator orderSpecIter = theOrderSpecs->begin();
 
+  bool haveSortKeys = (!t1.theSortKeys.empty() && !t2.theSortKeys.empty());
+  csize col = 0;
+
   while (t1iter != t1end)
   {
-    long cmp = compare(*t1iter,
-                        *t2iter,
-                        orderSpecIter->theDescending,
-                        orderSpecIter->theEmptyLeast,
-                        orderSpecIter->theNativeCompare,
-                        orderSpecIter->theCollator);
+    long cmp;
+
+    if (haveSortKeys &&
+        !t1.theSortKeys[col].empty() &&
+        !t2.theSortKeys[col].empty())
+    {
+      cmp = descAsc(compareSortKeys(t1.theSortKeys[col], t2.theSortKeys[col]),
+                    orderSpecIter->theDescending);
+    }
+    else
+    {
+      cmp = compare(*t1iter,
+                    *t2iter,
+                    orderSpecIter->theDescending,
+                    orderSpecIter->theEmptyLeast,
+                    orderSpecIter->theNativeCompare,
+                    orderSpecIter->theCollator);
+    }
+
     if (cmp > 0)
     {
       return false;
@@ -54,6 +134,7 @@ bool SortTupleCmp::operator()(const SortTuple& t1, const SortTuple& t2) const
     ++t1iter;
     ++t2iter;
     ++orderSpecIter;
+    ++col;
   }
   return false;
 }
@@ -65,6 +65,14 @@ public:
   */
   bool operator()(const SortTuple& t1, const SortTuple& t2) const;
 
+  /**
+     Computes the sort keys of the string key values of the given sort tuples
+     in the columns whose collation does not compare code points, so that
+     operator() can compare these values byte-wise instead of calling the
+     collator for every comparison.
+  */
+  void computeSortKeys(std::vector<SortTuple>& sortTable) const;
+
   /**
      Does the actual comparision. Returns:
      -1, if item1 < item2
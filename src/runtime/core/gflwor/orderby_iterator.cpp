@@ -340,6 +340,8 @@ bool OrderByIterator::nextImpl(store::Item_t& result, PlanState& planState) cons
                      theSctx->get_typemanager(),
                      &theOrderSpecs);
 
+    cmp.computeSortKeys(iterState->theSortTable);
+
     if (theStable)
     {
       std::stable_sort(iterState->theSortTable.begin(),
@@ -20,6 +20,8 @@
 
 #include "common/shared_types.h"
 
+#include "zorbatypes/zstring.h"
+
 #include "runtime/base/plan_iterator.h"
 #include "runtime/core/gflwor/common.h"
 
@@ -111,18 +113,23 @@ public:
   For a simple flwor, the T data is an iterator I over a temp sequence that
   stores the result of the return clause computed for the current input-
   stream tuple.
+
+  theSortKeys : If some orderby column uses a collation that does not compare
+                code points, the collation sort keys of the string key values
+                in such columns (see SortTupleCmp::computeSortKeys()). Columns
+                without a sort key have an empty string here. Empty if no
+                column has a sort key.
 ********************************************************************************/
 class SortTuple
 {
 public:
   std::vector<store::Item*>   theKeyValues;
+  std::vector<zstring>        theSortKeys;
   ulong                       theDataPos;
 
 public:
   SortTuple() { }
 
-  ~SortTuple() { }
-
   void clear()
   {
     csize numColumns = theKeyValues.size();
@@ -136,6 +143,7 @@ public:
     }
 
     theKeyValues.clear();
+    theSortKeys.clear();
   }
 };
 
@@ -135,6 +135,8 @@ SERIALIZABLE_CLASS_VERSIONS(DescendantAxisIterator)
 
 SERIALIZABLE_CLASS_VERSIONS(DescendantSelfAxisIterator)
 
+SERIALIZABLE_CLASS_VERSIONS(DescendantPathIterator)
+
 SERIALIZABLE_CLASS_VERSIONS(PrecedingAxisIterator)
 
 SERIALIZABLE_CLASS_VERSIONS(PrecedingReverseAxisIterator)
@@ -181,6 +183,9 @@ DEF_GET_NAME_AS_STRING(DescendantAxisIterator)
 UNARY_ACCEPT(DescendantSelfAxisIterator);
 DEF_GET_NAME_AS_STRING(DescendantSelfAxisIterator)
 
+UNARY_ACCEPT(DescendantPathIterator);
+DEF_GET_NAME_AS_STRING(DescendantPathIterator)
+
 UNARY_ACCEPT(PrecedingAxisIterator);
 DEF_GET_NAME_AS_STRING(PrecedingAxisIterator)
 
@@ -201,6 +206,20 @@ static inline bool isElementOrDocumentNode(const store::Item* node)
 }
 
 
+static inline bool isInSubtree(const store::Item* node, const store::Item* root)
+{
+  while (node != NULL)
+  {
+    if (node == root)
+      return true;
+
+    node = node->getParent();
+  }
+
+  return false;
+}
+
+
 
 /*******************************************************************************
 
@@ -436,6 +455,24 @@ doctest2:
 }
 
 
+/*******************************************************************************
+  Given a node that satisfies the test of this step, return false if none of
+  its descendants can satisfy the test as well. This is the case if the test
+  is a name test without wildcards and the tree of the node does not contain
+  any element that has an element descendant with the same name. A
+  schema-element test may also match elements of its substitution group, whose
+  names differ from the name of the node, so it never allows pruning.
+********************************************************************************/
+bool AxisIteratorHelper::mayMatchDescendants(const store::Item* node) const
+{
+  return (node->isRecursive() ||
+          theTestKind == match_anykind_test ||
+          theTestKind == match_xs_elem_test ||
+          (theTestKind == match_elem_test && theQName == NULL) ||
+          (theTestKind == match_name_test && theWildKind != match_no_wild));
+}
+
+
 /*******************************************************************************
 
 ********************************************************************************/
@@ -1282,6 +1319,42 @@ bool DescendantAxisIterator::nextImpl(store::Item_t& result, PlanState& planStat
 
     state->theCurrentPos = 0;
 
+    // A plain name test may be answered by the store, if it indexes the
+    // element names of the context node's tree. The matches are pulled one
+    // at a time, so that positional and existential consumers stop early.
+    if (theTestKind == match_name_test &&
+        theWildKind == match_no_wild &&
+        theNodeKind == store::StoreConsts::elementNode)
+    {
+      state->theIndexed =
+      state->theContextNode->getDescendantElements(theQName.getp());
+    }
+
+    if (state->theIndexed != NULL)
+    {
+      state->theIndexed->open();
+
+      while (state->theIndexed->next(result))
+      {
+        if (theTargetPos >= 0)
+        {
+          if (state->theCurrentPos++ == theTargetPos)
+          {
+            STACK_PUSH(true, state);
+            break;
+          }
+        }
+        else
+        {
+          STACK_PUSH(true, state);
+        }
+      }
+
+      state->theIndexed->close();
+      state->theIndexed = NULL;
+      continue;
+    }
+
     state->push(state->theContextNode);
 
     desc = state->top()->next();
@@ -1291,10 +1364,7 @@ bool DescendantAxisIterator::nextImpl(store::Item_t& result, PlanState& planStat
       if (nameOrKindTest(theSctx, desc, loc))
       {
         if (desc->getNodeKind() == store::StoreConsts::elementNode &&
-            (desc->isRecursive() ||
-             theTestKind == match_anykind_test ||
-             (theTestKind == match_elem_test && theQName == NULL) ||
-             (theTestKind == match_name_test && theWildKind != match_no_wild)))
+            mayMatchDescendants(desc))
         {
           state->push(desc);
         }
@@ -1388,10 +1458,7 @@ bool DescendantSelfAxisIterator::nextImpl(
         if ((descKind == store::StoreConsts::elementNode ||
              (descKind == store::StoreConsts::documentNode &&
               theTestKind == match_anykind_test)) &&
-            (desc->isRecursive() ||
-             theTestKind == match_anykind_test ||
-             (theTestKind == match_elem_test && theQName == NULL) ||
-             (theTestKind == match_name_test && theWildKind != match_no_wild)))
+            mayMatchDescendants(desc))
         {
           state->push(desc);
         }
@@ -1438,6 +1505,122 @@ bool DescendantSelfAxisIterator::nextImpl(
 }
 
 
+/*******************************************************************************
+
+********************************************************************************/
+void DescendantPathState::init(PlanState& planState)
+{
+  DescendantAxisState::init(planState);
+  thePrevContextNode = NULL;
+}
+
+
+void DescendantPathState::reset(PlanState& planState)
+{
+  DescendantAxisState::reset(planState);
+  thePrevContextNode = NULL;
+}
+
+
+void DescendantPathState::push(const store::Item* node, csize matched)
+{
+  if (theTop < theMatched.size())
+    theMatched[theTop] = matched;
+  else
+    theMatched.push_back(matched);
+
+  DescendantAxisState::push(node);
+}
+
+
+void DescendantPathIterator::serialize(::zorba::serialization::Archiver& ar)
+{
+  serialize_baseclass(ar,
+  (UnaryBaseIterator<DescendantPathIterator, DescendantPathState>*)this);
+
+  csize numSteps = theSteps.size();
+  ar & numSteps;
+
+  if (!ar.is_serializing_out())
+    theSteps.resize(numSteps);
+
+  for (csize i = 0; i < numSteps; ++i)
+    theSteps[i].serialize(ar);
+}
+
+
+bool DescendantPathIterator::nextImpl(
+    store::Item_t& result,
+    PlanState& planState) const
+{
+  const store::Item* desc;
+  csize lastStep = theSteps.size() - 1;
+  csize matched;
+
+  DescendantPathState* state;
+  DEFAULT_STACK_INIT(DescendantPathState, state, planState);
+
+  while (true)
+  {
+    if (!consumeNext(state->theContextNode, theChild.getp(), planState))
+      goto done;
+
+    if (!state->theContextNode->isNode())
+    {
+      assert(false);
+      throw XQUERY_EXCEPTION( err::XPTY0020, ERROR_LOC( loc ) );
+    }
+
+    if (!isElementOrDocumentNode(state->theContextNode.getp()) ||
+        isInSubtree(state->theContextNode.getp(),
+                    state->thePrevContextNode.getp()))
+      continue;
+
+    state->thePrevContextNode = state->theContextNode;
+
+    state->push(state->theContextNode, 0);
+
+    desc = state->top()->next();
+
+    while (desc != NULL)
+    {
+      matched = state->topMatched();
+
+      if (matched == lastStep &&
+          theSteps[lastStep].nameOrKindTest(theSctx, desc, loc))
+      {
+        if (desc->getNodeKind() == store::StoreConsts::elementNode &&
+            theSteps[lastStep].mayMatchDescendants(desc))
+        {
+          state->push(desc, matched);
+        }
+
+        result = desc;
+        STACK_PUSH(true, state);
+      }
+      else if (desc->getNodeKind() == store::StoreConsts::elementNode)
+      {
+        if (matched < lastStep &&
+            theSteps[matched].nameOrKindTest(theSctx, desc, loc))
+          ++matched;
+
+        state->push(desc, matched);
+      }
+
+      while (!state->empty() && (desc = state->top()->next()) == NULL)
+      {
+        state->pop();
+      }
+    }
+
+    state->clear();
+  }
+
+ done:
+  STACK_END(state);
+}
+
+
 /*******************************************************************************
 
 ********************************************************************************/
@@ -1552,10 +1735,7 @@ bool PrecedingAxisIterator::nextImpl(store::Item_t& result, PlanState& planState
           if (nameOrKindTest(theSctx, desc, loc))
           {
             if (desc->getNodeKind() == store::StoreConsts::elementNode &&
-                (desc->isRecursive() ||
-                 theTestKind == match_anykind_test ||
-                 (theTestKind == match_elem_test && theQName == NULL) ||
-                 (theTestKind == match_name_test && theWildKind != match_no_wild)))
+                mayMatchDescendants(desc))
             {
               state->push(desc);
             }
@@ -1742,10 +1922,7 @@ bool PrecedingReverseAxisIterator::nextImpl(
 
         if (nameOrKindTest(theSctx, child, loc))
         {
-          if (child->isRecursive() ||
-              theTestKind == match_anykind_test ||
-              (theTestKind == match_elem_test && theQName == NULL) ||
-              (theTestKind == match_name_test && theWildKind != match_no_wild))
+          if (mayMatchDescendants(child))
           {
             state->push(child);
           }
@@ -1776,10 +1953,7 @@ bool PrecedingReverseAxisIterator::nextImpl(
             {
               if (nameOrKindTest(theSctx, desc, loc))
               {
-                if (desc->isRecursive() ||
-                    theTestKind == match_anykind_test ||
-                    (theTestKind == match_elem_test && theQName == NULL) ||
-                    (theTestKind == match_name_test && theWildKind != match_no_wild))
+                if (mayMatchDescendants(desc))
                 {
                   state->push(desc); // recursive traversal
                 }
@@ -1955,10 +2129,7 @@ bool FollowingAxisIterator::nextImpl(
           if (nameOrKindTest(theSctx, desc, loc))
           {
             if (desc->getNodeKind() == store::StoreConsts::elementNode &&
-                (desc->isRecursive() ||
-                 theTestKind == match_anykind_test ||
-                 (theTestKind == match_elem_test && theQName == NULL) ||
-                 (theTestKind == match_name_test && theWildKind != match_no_wild)))
+                mayMatchDescendants(desc))
             {
               state->push(desc);
             }
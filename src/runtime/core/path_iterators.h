@@ -113,6 +113,8 @@ public:
       static_context* sctx,
       const store::Item* node,
       const QueryLoc& loc) const;
+
+  bool mayMatchDescendants(const store::Item* node) const;
 };
 
 
@@ -625,8 +627,10 @@ public:
   typedef std::pair<const store::Item*, store::ChildrenIterator*> PathPair;
 
 public:
-  ulong                 theTop;
-  std::vector<PathPair> theCurrentPath;
+  ulong                       theTop;
+  std::vector<PathPair>       theCurrentPath;
+
+  store::Iterator_t           theIndexed;
 
 public:
   DescendantAxisState() : theTop(0) {}
@@ -650,6 +654,12 @@ public:
     }
 
     theTop = 0;
+
+    if (theIndexed != NULL)
+    {
+      theIndexed->close();
+      theIndexed = NULL;
+    }
   }
 
   const store::Item* topNode() const
@@ -739,6 +749,90 @@ public:
 };
 
 
+/*******************************************************************************
+  State for DescendantPathIterator. theMatched[i] is the number of steps that
+  are matched by the node at position i of the current path or by one of its
+  ancestors below the context node (at most the number of steps minus 1).
+********************************************************************************/
+class DescendantPathState : public DescendantAxisState
+{
+public:
+  std::vector<csize>  theMatched;
+  store::Item_t       thePrevContextNode;
+
+public:
+  void init(PlanState&);
+
+  void reset(PlanState&);
+
+  csize topMatched() const
+  {
+    return theMatched[theTop-1];
+  }
+
+  void push(const store::Item* node, csize matched);
+};
+
+
+/*******************************************************************************
+  Evaluates a chain of 2 or more descendant steps, e.g. $doc//a//b, whose
+  steps have been simplified to descendant::a/descendant::b, in a single
+  walk over the subtree of each context node. The walk keeps, for each node
+  on the current path, the length of the longest prefix of the steps that
+  are matched by that node and its ancestors, and a node is returned if its
+  parent has matched all the steps except the last one and the node itself
+  satisfies the test of the last step. As a result, every node is visited
+  once, and the nodes are returned in document order and without duplicates
+  as long as the context nodes are in document order. A context node that is
+  in the subtree of the previous context node is skipped, because all the
+  nodes it would return have been returned already.
+
+  The plan generator creates this iterator by fusing consecutive
+  DescendantAxisIterators.
+
+  theSteps : The node tests of the steps, in path order.
+********************************************************************************/
+class DescendantPathIterator : public UnaryBaseIterator<DescendantPathIterator,
+                                                        DescendantPathState>
+{
+protected:
+  std::vector<AxisIteratorHelper> theSteps;
+
+public:
+  SERIALIZABLE_CLASS(DescendantPathIterator);
+  SERIALIZABLE_CLASS_CONSTRUCTOR2T(
+  DescendantPathIterator,
+  UnaryBaseIterator<DescendantPathIterator, DescendantPathState>);
+  void serialize(::zorba::serialization::Archiver& ar);
+
+public:
+  DescendantPathIterator(
+        static_context* sctx,
+        const QueryLoc& loc,
+        PlanIter_t input,
+        const AxisIteratorHelper& step1,
+        const AxisIteratorHelper& step2)
+    :
+    UnaryBaseIterator<DescendantPathIterator, DescendantPathState>(sctx, loc, input)
+  {
+    theSteps.push_back(step1);
+    theSteps.push_back(step2);
+  }
+
+  ~DescendantPathIterator() {}
+
+  void addStep(const AxisIteratorHelper& step) { theSteps.push_back(step); }
+
+  const std::vector<AxisIteratorHelper>& getSteps() const { return theSteps; }
+
+  void accept(PlanIterVisitor& v) const;
+
+  zstring getNameAsString() const;
+
+  bool nextImpl(store::Item_t& result, PlanState& planState) const;
+};
+
+
 /*******************************************************************************
 
 ********************************************************************************/
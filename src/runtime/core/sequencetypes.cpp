@@ -206,13 +206,30 @@ CastIterator::CastIterator(
     const QueryLoc& loc,
     PlanIter_t& child,
     const xqtref_t& castType,
-    bool allowEmpty)
+    bool allowEmpty,
+    const xqtref_t& inputType)
   : 
   UnaryBaseIterator<CastIterator, CastIteratorState>(sctx, loc, child),
   theAllowEmpty(allowEmpty),
+  theInputTypeCode(store::XS_LAST),
   theNsCtx(theSctx)
 {
-  theCastType = TypeOps::prime_type(sctx->get_typemanager(), *castType);
+  TypeManager* tm = sctx->get_typemanager();
+
+  theCastType = TypeOps::prime_type(tm, *castType);
+
+  if (inputType != NULL)
+  {
+    xqtref_t inputPrimeType = TypeOps::prime_type(tm, *inputType);
+
+    if (inputPrimeType->type_kind() == XQType::ATOMIC_TYPE_KIND)
+    {
+      theInputTypeCode = static_cast<const AtomicXQType*>(inputPrimeType.getp())->
+                         get_type_code();
+    }
+  }
+
+  resolveCast();
 }
 
 
@@ -226,8 +243,25 @@ void CastIterator::serialize(::zorba::serialization::Archiver& ar)
   serialize_baseclass(ar, (UnaryBaseIterator<CastIterator, CastIteratorState>*)this);
   ar & theCastType;
   ar & theAllowEmpty;
+  SERIALIZE_ENUM(store::SchemaTypeCode, theInputTypeCode);
 
   theNsCtx.setStaticContext(theSctx);
+
+  if (!ar.is_serializing_out())
+    resolveCast();
+}
+
+
+void CastIterator::resolveCast()
+{
+  if (theInputTypeCode != store::XS_LAST &&
+      theCastType->type_kind() == XQType::ATOMIC_TYPE_KIND)
+  {
+    GenericCast::resolveCast(
+        theInputTypeCode,
+        static_cast<const AtomicXQType*>(theCastType.getp())->get_type_code(),
+        theResolvedCast);
+  }
 }
 
 
@@ -255,9 +289,17 @@ bool CastIterator::nextImpl(store::Item_t& result, PlanState& planState) const
   {
     if (theCastType->type_kind() == XQType::ATOMIC_TYPE_KIND)
     {
-      targetType = static_cast<const AtomicXQType*>(theCastType.getp())->get_type_code();
+      if (theResolvedCast.isResolved())
+      {
+        GenericCast::castToBuiltinAtomic(result, item, theResolvedCast, &theNsCtx, loc);
+      }
+      else
+      {
+        targetType = static_cast<const AtomicXQType*>(theCastType.getp())->
+                     get_type_code();
 
-      GenericCast::castToBuiltinAtomic(result, item, targetType, &theNsCtx, loc);
+        GenericCast::castToBuiltinAtomic(result, item, targetType, &theNsCtx, loc);
+      }
 
       STACK_PUSH(true, state);
     }
@@ -382,15 +424,19 @@ PromoteIterator::PromoteIterator(
     PlanIter_t& child,
     const xqtref_t& promoteType,
     PromoteErrorKind err,
-    store::Item_t qname)
+    store::Item_t qname,
+    bool atomize)
   :
-  UnaryBaseIterator<PromoteIterator, PlanIteratorState>(sctx, loc, child),
+  UnaryBaseIterator<PromoteIterator, PromoteIteratorState>(sctx, loc, child),
   theErrorKind(err),
   theQName(qname),
-  theNsCtx(theSctx)
+  theNsCtx(theSctx),
+  theAtomize(atomize)
 {
   thePromoteType = TypeOps::prime_type(sctx->get_typemanager(), *promoteType);
   theQuantifier = promoteType->get_quantifier(); 
+
+  resolveUntypedCast();
 }
 
 
@@ -402,14 +448,141 @@ PromoteIterator::~PromoteIterator()
 void PromoteIterator::serialize(::zorba::serialization::Archiver& ar)
 {
   serialize_baseclass(ar,
-  (UnaryBaseIterator<PromoteIterator, PlanIteratorState>*)this);
+  (UnaryBaseIterator<PromoteIterator, PromoteIteratorState>*)this);
 
   ar & thePromoteType;
   SERIALIZE_ENUM(SequenceType::Quantifier, theQuantifier);
   SERIALIZE_ENUM(PromoteErrorKind, theErrorKind);
   ar & theQName;
+  ar & theAtomize;
 
   theNsCtx.setStaticContext(theSctx);
+
+  if (!ar.is_serializing_out())
+    resolveUntypedCast();
+}
+
+
+/*******************************************************************************
+  Resolve the cast from xs:untypedAtomic to the promote type, if the promote
+  type is a builtin atomic type that untyped items can be promoted to (see
+  GenericCast::promote()).
+********************************************************************************/
+void PromoteIterator::resolveUntypedCast()
+{
+  if (thePromoteType->type_kind() != XQType::ATOMIC_TYPE_KIND)
+    return;
+
+  store::SchemaTypeCode targetType =
+  static_cast<const AtomicXQType*>(thePromoteType.getp())->get_type_code();
+
+  if (TypeOps::is_subtype(targetType, store::XS_UNTYPED_ATOMIC) ||
+      TypeOps::is_subtype(targetType, store::XS_QNAME) ||
+      TypeOps::is_subtype(targetType, store::XS_NOTATION))
+    return;
+
+  GenericCast::resolveCast(store::XS_UNTYPED_ATOMIC, targetType, theUntypedCast);
+}
+
+
+/*******************************************************************************
+  Promote the given atomic item to the promote type. Untyped atomic items go
+  directly through the cast resolved by resolveUntypedCast(), if any.
+********************************************************************************/
+bool PromoteIterator::promote(
+    store::Item_t& result,
+    store::Item_t& item,
+    const TypeManager* tm) const
+{
+  if (theUntypedCast.isResolved() &&
+      item->getTypeCode() == store::XS_UNTYPED_ATOMIC)
+  {
+    return GenericCast::castToBuiltinAtomic(result, item, theUntypedCast, NULL, loc);
+  }
+
+  return GenericCast::promote(result, item, thePromoteType, &theNsCtx, tm, loc);
+}
+
+
+/*******************************************************************************
+  Get the next item of the input, atomizing it first if theAtomize is set (see
+  FnDataIterator::nextImpl()).
+********************************************************************************/
+bool PromoteIterator::consumeAtomic(
+    store::Item_t& result,
+    PromoteIteratorState* state,
+    PlanState& planState) const
+{
+  if (!theAtomize)
+    return consumeNext(result, theChild.getp(), planState);
+
+  store::Item_t node;
+
+  while (true)
+  {
+    if (state->theTypedValueIter != NULL)
+    {
+      if (state->theTypedValueIter->next(result))
+        return true;
+
+      state->theTypedValueIter = NULL;
+    }
+
+    if (!consumeNext(result, theChild.getp(), planState))
+      return false;
+
+    switch (result->getKind())
+    {
+    case store::Item::ATOMIC:
+    {
+      return true;
+    }
+    case store::Item::NODE:
+    {
+      node.transfer(result);
+
+      try
+      {
+        node->getTypedValue(result, state->theTypedValueIter);
+      }
+      catch (ZorbaException& e)
+      {
+        set_source(e, loc);
+        throw;
+      }
+
+      if (state->theTypedValueIter == NULL)
+      {
+        if (result != NULL)
+          return true;
+      }
+      else
+      {
+        state->theTypedValueIter->open();
+      }
+
+      break;
+    }
+    case store::Item::OBJECT:
+    {
+      RAISE_ERROR(jerr::JNTY0004, loc, ERROR_PARAMS("object"));
+    }
+    case store::Item::ARRAY:
+    {
+      RAISE_ERROR(jerr::JNTY0004, loc, ERROR_PARAMS("array"));
+    }
+    case store::Item::FUNCTION:
+    {
+      store::Item_t fnName = result->getFunctionName();
+      RAISE_ERROR(err::FOTY0013, loc,
+      ERROR_PARAMS(fnName.getp() ? fnName->getStringValue() : zstring("???")));
+    }
+    default:
+    {
+      ZORBA_ASSERT(false);
+    }
+    }
+  }
 }
 
 
@@ -420,10 +593,10 @@ bool PromoteIterator::nextImpl(store::Item_t& result, PlanState& planState) cons
 
   const TypeManager* tm = theSctx->get_typemanager();
 
-  PlanIteratorState* state;
-  DEFAULT_STACK_INIT(PlanIteratorState, state, planState);
+  PromoteIteratorState* state;
+  DEFAULT_STACK_INIT(PromoteIteratorState, state, planState);
 
-  if (!consumeNext(item, theChild.getp(), planState))
+  if (!consumeAtomic(item, state, planState))
   {
     if (theQuantifier == SequenceType::QUANT_PLUS ||
         theQuantifier == SequenceType::QUANT_ONE)
@@ -434,13 +607,13 @@ bool PromoteIterator::nextImpl(store::Item_t& result, PlanState& planState) cons
   else if (theQuantifier == SequenceType::QUANT_QUESTION ||
            theQuantifier == SequenceType::QUANT_ONE)
   {
-    if (consumeNext(temp, theChild.getp(), planState))
+    if (consumeAtomic(temp, state, planState))
     {
       raiseError("sequence of more than one item");
     }
 
     // catch exceptions to add/change the error location
-    if (! GenericCast::promote(result, item, thePromoteType, &theNsCtx, tm, loc))
+    if (! promote(result, item, tm))
     {
       zstring valueType = tm->create_value_type(item)->toSchemaString();
       raiseError(valueType);
@@ -452,7 +625,7 @@ bool PromoteIterator::nextImpl(store::Item_t& result, PlanState& planState) cons
   {
     do
     {
-      if (! GenericCast::promote(result, item, thePromoteType, &theNsCtx, tm, loc))
+      if (! promote(result, item, tm))
       {
         zstring valueType = tm->create_value_type(item)->toSchemaString();
         raiseError(valueType);
@@ -462,7 +635,7 @@ bool PromoteIterator::nextImpl(store::Item_t& result, PlanState& planState) cons
         STACK_PUSH(true, state);
       }
     }
-    while (consumeNext(item, theChild.getp(), planState));
+    while (consumeAtomic(item, state, planState));
   }
 
   STACK_END(state);
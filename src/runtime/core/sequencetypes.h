@@ -25,6 +25,7 @@
 #include "runtime/base/narybase.h"
 
 #include "types/typeconstants.h"
+#include "types/casting.h"
 
 #include "compiler/expression/expr_consts.h"
 
@@ -87,15 +88,30 @@ public:
 };
 
 
+/*******************************************************************************
+  theInputTypeCode :
+  ------------------
+  The builtin atomic type of the input, if the static type of the input is one
+  (XS_LAST otherwise).
+
+  theResolvedCast :
+  -----------------
+  If both the input type and the cast type are builtin atomic types, the cast
+  from the one to the other, resolved once so that nextImpl() does not have to
+  look it up for each item. It is not serialized, but resolved again on load.
+********************************************************************************/
 class CastIterator : public UnaryBaseIterator<CastIterator, CastIteratorState> 
 {
   friend class PrinterVisitor;
 
 private:
-  xqtref_t          theCastType;
-  bool              theAllowEmpty;
+  xqtref_t                   theCastType;
+  bool                       theAllowEmpty;
+  store::SchemaTypeCode      theInputTypeCode;
 
-  namespace_context theNsCtx;
+  namespace_context          theNsCtx;
+
+  GenericCast::ResolvedCast  theResolvedCast;
 
 public:
   SERIALIZABLE_CLASS(CastIterator);
@@ -110,7 +126,8 @@ public:
       const QueryLoc& loc,
       PlanIter_t& child,
       const xqtref_t& castType,
-      bool allowEmpty);
+      bool allowEmpty,
+      const xqtref_t& inputType = NULL);
   
   ~CastIterator();
 
@@ -119,6 +136,9 @@ public:
   zstring getNameAsString() const;
   
   bool nextImpl(store::Item_t& result, PlanState& aPlanState) const;
+
+protected:
+  void resolveCast();
 };
 
 
@@ -163,13 +183,45 @@ public:
 };
 
 
+/*******************************************************************************
+
+********************************************************************************/
+class PromoteIteratorState : public PlanIteratorState
+{
+public:
+  store::Iterator_t  theTypedValueIter;
+
+  void init(PlanState& planState)
+  {
+    PlanIteratorState::init(planState);
+    theTypedValueIter = NULL;
+  }
+
+  void reset(PlanState& planState)
+  {
+    PlanIteratorState::reset(planState);
+    theTypedValueIter = NULL;
+  }
+};
+
+
 /*******************************************************************************
   Iterator which tries to promote an item to the passed target type. If it
   is not possible, a type error is thrown. If the type of the item is a 
   subtype of the target type, then no promotion is done (it's a noop).
+
+  theUntypedCast : If the promote type is a builtin atomic type that untyped
+               atomic items are promoted to by casting, that cast, resolved
+               once (see GenericCast::resolveCast()). It is not serialized,
+               but resolved again on load.
+
+  theAtomize : If true, the iterator atomizes its input itself, i.e., it does
+               the work of an fn:data iterator that the codegen has fused into
+               it. This saves an iterator (and a virtual call per item) in the
+               very common promote(data(E)) chains of function arguments.
 ********************************************************************************/
 class PromoteIterator : public UnaryBaseIterator<PromoteIterator,
-                                                 PlanIteratorState> 
+                                                 PromoteIteratorState> 
 {
   friend class PrinterVisitor;
 
@@ -179,12 +231,15 @@ private:
   PromoteErrorKind           theErrorKind;
   store::Item_t							 theQName; 
   namespace_context          theNsCtx;
+  bool                       theAtomize;
+
+  GenericCast::ResolvedCast  theUntypedCast;
 
 public:
   SERIALIZABLE_CLASS(PromoteIterator);
   SERIALIZABLE_CLASS_CONSTRUCTOR2T(
   PromoteIterator,
-  UnaryBaseIterator<PromoteIterator, PlanIteratorState>);
+  UnaryBaseIterator<PromoteIterator, PromoteIteratorState>);
   void serialize(::zorba::serialization::Archiver& ar);
 
 public:
@@ -194,10 +249,13 @@ public:
       PlanIter_t& child,
       const xqtref_t& promoteType,
       PromoteErrorKind err,
-      store::Item_t qname = NULL);
+      store::Item_t qname = NULL,
+      bool atomize = false);
 
   ~PromoteIterator();
 
+  bool atomizes() const { return theAtomize; }
+
   void accept(PlanIterVisitor& v) const;
 
   zstring getNameAsString() const;
@@ -205,6 +263,18 @@ public:
   bool nextImpl(store::Item_t& result, PlanState& aPlanState) const;
 
 protected:
+  bool consumeAtomic(
+      store::Item_t& result,
+      PromoteIteratorState* state,
+      PlanState& planState) const;
+
+  bool promote(
+      store::Item_t& result,
+      store::Item_t& item,
+      const TypeManager* tm) const;
+
+  void resolveUntypedCast();
+
   void raiseError(const zstring& valueType) const;
 };
 
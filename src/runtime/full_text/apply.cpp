@@ -357,6 +357,130 @@ static bool is_decendant( store::Item const *i, store::Item const *j ) {
   return false;
 }
 
+/**
+ * Matches query tokens as a phrase against document tokens starting at the
+ * current position of the latter.
+ *
+ * @param doc_tokens The document tokens.
+ * @param query_tokens The query tokens.
+ * @param ignore_item The item whose descendants' tokens are to be ignored, if
+ * any.
+ * @param matcher The token matcher to use.
+ * @param ts A pointer to the span to receive the matched tokens' positions.
+ * @param consumed If not \c nullptr, set to the number of document tokens
+ * consumed.
+ * @return Returns \c true only if the phrase matched.
+ */
+static bool match_phrase( FTTokenIterator &doc_tokens,
+                          FTTokenIterator &query_tokens,
+                          store::Item const *ignore_item,
+                          ft_token_matcher const &matcher,
+                          ft_token_span *ts,
+                          FTTokenIterator::index_t *consumed = nullptr ) {
+  FTToken const *dt, *dt_start = nullptr, *dt_end = nullptr;
+  store::Item const *dt_item = nullptr;
+  bool ignore = false;                  // pointless init. to stifle warning
+  bool matched = false;
+
+  if ( consumed )
+    *consumed = 0;
+  query_tokens.reset();
+  while ( (dt = doc_tokens.next()) ) {
+    if ( consumed )
+      ++*consumed;
+    if ( ignore_item ) {
+      //
+      // We are ignoring some item: see if this document token's item is a
+      // descendant of the ignored item.
+      //
+      if ( dt->item() != dt_item ) {
+        dt_item = dt->item();
+        ignore = is_decendant( dt_item, ignore_item );
+      }
+      if ( ignore )
+        continue;
+    }
+    FTToken const *const qt = query_tokens.next();
+    if ( !qt )
+      break;
+    if ( !matcher.match( *dt, *qt ) ) {
+      matched = false;
+      break;
+    }
+    matched = true;
+    if ( !dt_start )
+      dt_start = dt;
+    dt_end = dt;
+    if ( !query_tokens.hasNext() ) {
+      //
+      // Stop right after the last query token has matched so the document
+      // token after the phrase isn't consumed: it may start the next match.
+      //
+      break;
+    }
+  }
+
+  if ( matched && !query_tokens.hasNext() ) {
+    ts->pos.start  = dt_start->pos();
+    ts->pos.end    = dt_end->pos();
+    ts->sent.start = dt_start->sent();
+    ts->sent.end   = dt_end->sent();
+    ts->para.start = dt_start->para();
+    ts->para.end   = dt_end->para();
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Matches query tokens against document tokens by looking up the document
+ * tokens that match the first query token rather than trying every document
+ * token.  The result is exactly what the scan in match_tokens() gets.
+ *
+ * @return Returns \c false only if the document tokens can't be looked up
+ * (in which case nothing is done).
+ */
+static bool find_tokens( FTTokenIterator &doc_tokens,
+                         FTTokenIterator &query_tokens,
+                         ft_token_matcher const &matcher,
+                         ft_token_spans &result ) {
+  query_tokens.reset();
+  FTToken const *const qt0 = query_tokens.next();
+  if ( !qt0 )
+    return false;
+
+  int dt_selector;
+  FTToken::Stemmer const *stemmer;
+  FTToken::string_t const *qt0_value;
+  if ( !matcher.lookup_key( *qt0, &dt_selector, &stemmer, &qt0_value ) )
+    return false;
+
+  FTTokenIterator::index_list candidates;
+  if ( !doc_tokens.find( FTToken::string_t( *qt0_value ), dt_selector,
+                         stemmer, matcher.lang(), &candidates ) )
+    return false;
+
+  //
+  // A match consumes the document tokens it matched, so candidates that the
+  // scan would have skipped over are skipped here too.
+  //
+  FTTokenIterator::index_t next_start = doc_tokens.begin();
+  FOR_EACH( FTTokenIterator::index_list, c, candidates ) {
+    if ( *c < next_start )
+      continue;
+    doc_tokens.seek( *c );
+    ft_token_span ts;
+    FTTokenIterator::index_t consumed;
+    if ( match_phrase( doc_tokens, query_tokens, nullptr, matcher, &ts,
+                       &consumed ) ) {
+      result.push_back( ts );
+      next_start = *c + consumed;
+    } else
+      next_start = *c + 1;
+  }
+  return true;
+}
+
 /**
  * Matches query tokens against document tokens.
  */
@@ -369,18 +493,21 @@ static void match_tokens( FTTokenIterator &doc_tokens,
   dump( "match_tokens(): d_tokens: ", doc_tokens );
   dump( "match_tokens(): q_tokens: ", query_tokens );
 #endif
+  if ( !ignore_item && find_tokens( doc_tokens, query_tokens, matcher, result ) )
+    return;
+
   doc_tokens.reset();
   while ( doc_tokens.hasNext() ) {
     FTTokenIterator::Mark_t mark( doc_tokens.pos() );
-    FTToken const *dt;
-    store::Item const *dt_item = nullptr;
-    bool ignore = false;                // pointless init. to stifle warning
 
     if ( ignore_item ) {
       //
       // We are ignoring some item: see if this document token's item is a
       // descendant of the ignored item.
       //
+      FTToken const *dt;
+      store::Item const *dt_item = nullptr;
+      bool ignore = false;              // pointless init. to stifle warning
       while ( (dt = doc_tokens.next()) ) {
         if ( dt->item() != dt_item ) {
           dt_item = dt->item();
@@ -398,47 +525,10 @@ static void match_tokens( FTTokenIterator &doc_tokens,
       }
     }
 
-    FTToken const *dt_start = nullptr, *dt_end = nullptr;
-    dt_item = nullptr;
-    bool matched = false;
-
-    query_tokens.reset();
-    while ( (dt = doc_tokens.next()) ) {
-      if ( ignore_item ) {
-        //
-        // We are ignoring some item: see if this document token's item is a
-        // descendant of the ignored item.
-        //
-        if ( dt->item() != dt_item ) {
-          dt_item = dt->item();
-          ignore = is_decendant( dt_item, ignore_item );
-        }
-        if ( ignore )
-          continue;
-      }
-      FTToken const *const qt = query_tokens.next();
-      if ( !qt )
-        break;
-      if ( !matcher.match( *dt, *qt ) ) {
-        matched = false;
-        break;
-      }
-      matched = true;
-      if ( !dt_start )
-        dt_start = dt;
-      dt_end = dt;
-    }
-
-    if ( matched && !query_tokens.hasNext() ) {
-      ft_token_span ts;
-      ts.pos.start  = dt_start->pos();
-      ts.pos.end    = dt_end->pos();
-      ts.sent.start = dt_start->sent();
-      ts.sent.end   = dt_end->sent();
-      ts.para.start = dt_start->para();
-      ts.para.end   = dt_end->para();
+    ft_token_span ts;
+    if ( match_phrase( doc_tokens, query_tokens, ignore_item, matcher, &ts ) )
       result.push_back( ts );
-    } else {
+    else {
       doc_tokens.pos( mark );
       doc_tokens.next();
     }
@@ -97,49 +97,82 @@ operator()( string_t const &word, iso639_1::type lang,
     *result = word;
 }
 
-///////////////////////////////////////////////////////////////////////////////
-
-bool ft_token_matcher::match( FTToken const &dt, FTToken const &qt ) const {
-  int dt_selector = FTToken::original;
-  int qt_selector = FTToken::original;
+void const* ft_token_matcher::match_stemmer::identity() const {
+  //
+  // Every match_stemmer stems the same way as the others using the same
+  // provider.
+  //
+  return provider_;
+}
 
-  if ( stop_words_ ) {
-    //
-    // Perform stop-word comparison early so as not to waste time doing the
-    // stuff below for stop-words.
-    //
-    // Perform stop-word comparison in lower-case since stop-word lists are in
-    // lower-case.
-    //
-    if ( stop_words_->contains( qt.value( FTToken::lower ) ) )
-      return true;
-  }
+///////////////////////////////////////////////////////////////////////////////
 
-  if ( stemming_ )
-    return dt.value( stemmer_, lang_ ) == qt.value( stemmer_, lang_ );
+void ft_token_matcher::get_selectors( int *dt_selector,
+                                      int *qt_selector ) const {
+  *dt_selector = FTToken::original;
+  *qt_selector = FTToken::original;
 
   if ( case_option_ ) {
     switch ( case_option_->get_mode() ) {
       case ft_case_mode::insensitive:
-        dt_selector |= FTToken::lower;
-        qt_selector |= FTToken::lower;
+        *dt_selector |= FTToken::lower;
+        *qt_selector |= FTToken::lower;
         break;
       case ft_case_mode::sensitive:
         // do nothing
         break;
       case ft_case_mode::lower:
-        qt_selector |= FTToken::lower;
+        *qt_selector |= FTToken::lower;
         break;
       case ft_case_mode::upper:
-        qt_selector |= FTToken::upper;
+        *qt_selector |= FTToken::upper;
         break;
     }
   }
 
   if ( diacritics_insensitive_ ) {
-    dt_selector |= FTToken::ascii;
-    qt_selector |= FTToken::ascii;
+    *dt_selector |= FTToken::ascii;
+    *qt_selector |= FTToken::ascii;
   }
+}
+
+bool ft_token_matcher::lookup_key( FTToken const &qt, int *dt_selector,
+                                   FTToken::Stemmer const **stemmer,
+                                   FTToken::string_t const **value ) const {
+  if ( stop_words_ || wildcards_ )
+    return false;
+
+  if ( stemming_ ) {
+    *dt_selector = FTToken::original;
+    *stemmer = &stemmer_;
+    *value = &qt.value( stemmer_, lang_ );
+  } else {
+    int qt_selector;
+    get_selectors( dt_selector, &qt_selector );
+    *stemmer = nullptr;
+    *value = &qt.value( qt_selector, lang_ );
+  }
+  return true;
+}
+
+bool ft_token_matcher::match( FTToken const &dt, FTToken const &qt ) const {
+  if ( stop_words_ ) {
+    //
+    // Perform stop-word comparison early so as not to waste time doing the
+    // stuff below for stop-words.
+    //
+    // Perform stop-word comparison in lower-case since stop-word lists are in
+    // lower-case.
+    //
+    if ( stop_words_->contains( qt.value( FTToken::lower ) ) )
+      return true;
+  }
+
+  if ( stemming_ )
+    return dt.value( stemmer_, lang_ ) == qt.value( stemmer_, lang_ );
+
+  int dt_selector, qt_selector;
+  get_selectors( &dt_selector, &qt_selector );
 
   if ( wildcards_ )
     return dt.value( dt_selector ) == qt.wildcard( qt_selector );
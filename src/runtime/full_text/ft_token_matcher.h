@@ -47,16 +47,44 @@ public:
    */
   bool match( FTToken const &dt, FTToken const &qt ) const;
 
+  /**
+   * Gets how document tokens are to be found that match the given query token
+   * by looking them up in an index rather than comparing each one, i.e., the
+   * document tokens that match are exactly those whose value, modified by \a
+   * dt_selector or \a stemmer, is equal to \a value.  This is possible only
+   * when neither wildcards nor stop-words are in effect.
+   *
+   * @param qt The query token.
+   * @param dt_selector A pointer to receive the selector for document tokens.
+   * @param stemmer A pointer to receive the stemmer for document tokens, if
+   * any.
+   * @param value A pointer to receive the value to look up.
+   * @return Returns \c true only if matching tokens can be looked up.
+   */
+  bool lookup_key( FTToken const &qt, int *dt_selector,
+                   FTToken::Stemmer const **stemmer,
+                   FTToken::string_t const **value ) const;
+
+  /**
+   * Gets the language to use for tokens that don't have one.
+   */
+  locale::iso639_1::type lang() const {
+    return lang_;
+  }
+
 private:
   class match_stemmer : public FTToken::Stemmer {
   public:
     match_stemmer();
     // inherited
     void operator()( string_t const&, locale::iso639_1::type, string_t* ) const;
+    void const* identity() const;
   private:
     internal::StemmerProvider const *const provider_;
   };
 
+  void get_selectors( int *dt_selector, int *qt_selector ) const;
+
   ftcase_option const *const case_option_;
   bool const diacritics_insensitive_;
   locale::iso639_1::type const lang_;
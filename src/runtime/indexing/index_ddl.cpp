@@ -595,10 +595,11 @@ ProbeIndexPointValueIteratorState::~ProbeIndexPointValueIteratorState()
 void ProbeIndexPointValueIteratorState::init(PlanState& planState) 
 {
   PlanIteratorState::init(planState);
-  theQname = 0;
+  theQname = NULL;
   theIndexDecl = 0;
-  theIndex = 0;
+  theIndex = NULL;
   theIterator = NULL;
+  theCondition = NULL;
 }
 
 
@@ -609,11 +610,6 @@ void ProbeIndexPointValueIteratorState::reset(PlanState& state)
   {
     theIterator->close();
   }
-
-  theQname = 0;
-  theIndexDecl = 0;
-  theIndex = 0;
-  theIterator = NULL;
 }
 
 
@@ -746,8 +742,6 @@ void ProbeIndexPointValueIterator::getIndex(
 
   if (state->theQname == NULL || !state->theQname->equals(qnameItem)) 
   {
-    state->theQname = qnameItem;
-
     if ((state->theIndexDecl = theSctx->lookup_index(qnameItem)) == NULL)
     {
       RAISE_ERROR(zerr::ZDDY0021_INDEX_NOT_DECLARED, loc,
@@ -763,18 +757,26 @@ void ProbeIndexPointValueIterator::getIndex(
                    state->theIndexDecl->getNumKeyExprs()));
     }
 
-    state->theIndex = (state->theIndexDecl->isTemp() ?
-                       planState.theLocalDynCtx->getIndex(qnameItem) :
-                       GENV_STORE.getIndex(state->theQname));
-      
-    if (state->theIndex == NULL)
-    {
-      RAISE_ERROR(zerr::ZDDY0023_INDEX_DOES_NOT_EXIST, loc,
-      ERROR_PARAMS(qnameItem->getStringValue()));
-    }
+    state->theQname = qnameItem;
+  }
+
+  // A temp index may have been rebuilt since the last probe.
+  store::Index* index = (state->theIndexDecl->isTemp() ?
+                         planState.theLocalDynCtx->getIndex(qnameItem) :
+                         GENV_STORE.getIndex(qnameItem));
       
+  if (index == NULL)
+  {
+    RAISE_ERROR(zerr::ZDDY0023_INDEX_DOES_NOT_EXIST, loc,
+    ERROR_PARAMS(qnameItem->getStringValue()));
+  }
+
+  if (index != state->theIndex.getp())
+  {
+    state->theIndex = index;
     state->theIterator = GENV_STORE.getIteratorFactory()->
     createIndexProbeIterator(state->theIndex);
+    state->theCondition = NULL;
   }
 }
 
@@ -789,7 +791,17 @@ store::IndexCondition_t ProbeIndexPointValueIterator::createCondition(
   csize numChildren = theChildren.size();
   csize numNonKeyParams = (theSkip ? 2 : 1);
 
-  cond = state->theIndex->createCondition(store::IndexCondition::POINT_VALUE);
+  if (state->theCondition == NULL)
+  {
+    state->theCondition =
+    state->theIndex->createCondition(store::IndexCondition::POINT_VALUE);
+  }
+  else
+  {
+    state->theCondition->clear();
+  }
+
+  cond = state->theCondition;
 
   for (csize i = numNonKeyParams; i < numChildren; ++i) 
   {
@@ -947,8 +959,6 @@ void ProbeIndexPointGeneralIterator::getIndex(
 
   if (state->theQname == NULL || !state->theQname->equals(qnameItem)) 
   {
-    state->theQname = qnameItem;
-      
     if ((state->theIndexDecl = theSctx->lookup_index(qnameItem)) == NULL)
     {
       RAISE_ERROR(zerr::ZDDY0021_INDEX_NOT_DECLARED, loc,
@@ -971,18 +981,26 @@ void ProbeIndexPointGeneralIterator::getIndex(
                    state->theIndexDecl->getNumKeyExprs()));
     }
 
-    state->theIndex = (state->theIndexDecl->isTemp() ?
-                       planState.theLocalDynCtx->getIndex(qnameItem) :
-                       GENV_STORE.getIndex(state->theQname));
+    state->theQname = qnameItem;
+  }
 
-    if (state->theIndex == NULL)
-    {
-      RAISE_ERROR(zerr::ZDDY0023_INDEX_DOES_NOT_EXIST, loc,
-      ERROR_PARAMS(qnameItem->getStringValue()));
-    }
-    
+  // A temp index may have been rebuilt since the last probe.
+  store::Index* index = (state->theIndexDecl->isTemp() ?
+                         planState.theLocalDynCtx->getIndex(qnameItem) :
+                         GENV_STORE.getIndex(qnameItem));
+
+  if (index == NULL)
+  {
+    RAISE_ERROR(zerr::ZDDY0023_INDEX_DOES_NOT_EXIST, loc,
+    ERROR_PARAMS(qnameItem->getStringValue()));
+  }
+
+  if (index != state->theIndex.getp())
+  {
+    state->theIndex = index;
     state->theIterator = GENV_STORE.getIteratorFactory()->
                          createIndexProbeIterator(state->theIndex);
+    state->theCondition = NULL;
   }
 }
 
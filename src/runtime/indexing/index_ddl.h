@@ -331,14 +331,20 @@ public:
 
   Note: the translator wraps calls to this function with an OP_NODE_SORT_ASC
   function.
+
+  The state keeps the index, its probe iterator, and the probe condition across
+  resets: a probe that is reset once per tuple of an enclosing flwor (as in the
+  hashjoins created by the IndexJoinRule) only checks that the same index is
+  still bound under the given name, and reuses them if so.
 ********************************************************************************/
 class ProbeIndexPointValueIteratorState : public PlanIteratorState
 {
 public:
-  const store::Item            * theQname; 
+  store::Item_t                  theQname; 
   const IndexDecl              * theIndexDecl;
-  store::Index                 * theIndex; 
+  store::Index_t                 theIndex; 
   store::IndexProbeIterator_t    theIterator;
+  store::IndexCondition_t        theCondition;
 
 public:
   ProbeIndexPointValueIteratorState();
@@ -407,9 +413,6 @@ protected:
 ********************************************************************************/
 class ProbeIndexPointGeneralIteratorState : public ProbeIndexPointValueIteratorState
 {
-public:
-  store::IndexCondition_t theCondition;
-
 public:
   ProbeIndexPointGeneralIteratorState();
 
@@ -127,6 +127,7 @@ void loader::add_value( store::Item_t const &value ) {
 void loader::clear() {
   parser_.clear();
   clear_stack();
+  strings_.clear();
   stripped_top_level_array_ = false;
 }
 
@@ -202,7 +203,7 @@ bool loader::next( store::Item_t *result ) {
           }
           break;
         case token::string:
-          s = t.get_value();
+          strings_.intern( t.get_value().data(), t.get_value().size(), s );
           GENV_ITEMFACTORY->createString( item, s );
           break;
         case 'F':
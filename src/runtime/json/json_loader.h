@@ -27,6 +27,7 @@
 #include "store/api/item.h"
 #include "util/json_parser.h"
 #include "zorbatypes/zstring.h"
+#include "zorbautils/string_dictionary.h"
 
 namespace zorba {
 namespace json {
@@ -123,6 +124,12 @@ private:
   parser parser_;
   bool const strip_top_level_array_;
   bool stripped_top_level_array_;
+
+  /**
+   * Short string values and object keys are interned here so that repeated
+   * ones share their string representation.
+   */
+  StringDictionary strings_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
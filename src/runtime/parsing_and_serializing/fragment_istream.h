@@ -19,8 +19,11 @@
 
 #include <iostream>
 #include <libxml/parser.h>
+#include <zorba/util/mem_streambuf.h>
 #include <store/api/iterator.h>
 
+#include "zorbatypes/zstring.h"
+
 namespace zorba {
 
 /**
@@ -43,6 +46,8 @@ public:
 public:
   std::istringstream* theIss;
   std::istream* theStream;
+  zstring theString;                // the input, if it is not streamable
+  mem_streambuf theStringBuf;       // reads theString in place
   StreamReleaser theStreamReleaser;
   std::vector<char> theBuffer;
   unsigned long bytes_in_buffer;
@@ -79,6 +84,22 @@ public:
   {
   };
 
+  /**
+   * Sets the (already materialized) string to parse. The string is swapped
+   * into this object and read in place through this stream, rather than
+   * being copied into an istringstream, so that a large input is held in
+   * memory only once while its fragments are parsed incrementally.
+   *
+   * @param s The string to parse. It is empty on return.
+   */
+  void setString(zstring& s)
+  {
+    theString.swap(s);
+    theStringBuf.set(const_cast<char*>(theString.data()), theString.size());
+    rdbuf(&theStringBuf);
+    theStream = this;
+  }
+
   bool stream_is_consumed()
   {
     return reached_eof && current_offset >= bytes_in_buffer;
@@ -114,6 +135,13 @@ public:
       xmlFreeParserCtxt(ctxt);
     }
 
+    if (theStream == this)
+    {
+      rdbuf(NULL);
+      theString.clear();
+      theStringBuf.set(nullptr, nullptr);
+    }
+
     theIss = NULL;
     theStream = NULL;
     bytes_in_buffer = 0;
@@ -214,8 +214,7 @@ bool FnZorbaParseXmlFragmentIterator::nextImpl(
     else
     {
       result->getStringValue2(docString);
-      state->theFragmentStream.theIss = new std::istringstream(docString.c_str());
-      state->theFragmentStream.theStream = state->theFragmentStream.theIss;
+      state->theFragmentStream.setString(docString);
     }
 
     // read options
@@ -435,6 +434,9 @@ bool FnParseXmlFragmentIterator::nextImpl(
 
   if (consumeNext(result, theChildren[0].getp(), planState))
   {
+    // The whole input is parsed below, while the item still owns its stream.
+    // Unlike parse-xml:parse(), do not take the stream over, so that the item
+    // can be parsed again.
     if (result->isStreamable())
     {
       state->theFragmentStream.theStream = &result->getStream();
@@ -442,8 +444,7 @@ bool FnParseXmlFragmentIterator::nextImpl(
     else
     {
       result->getStringValue2(docString);
-      state->theFragmentStream.theIss = new std::istringstream(docString.c_str());
-      state->theFragmentStream.theStream = state->theFragmentStream.theIss;
+      state->theFragmentStream.setString(docString);
     }
 
     state->theProperties.setBaseUri(theSctx->get_base_uri());
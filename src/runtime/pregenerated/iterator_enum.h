@@ -59,6 +59,7 @@
   TYPE_ZorbaTruncateCollectionIterator,
   TYPE_IsAvailableIndexIterator,
   TYPE_AvailableIndexesIterator,
+  TYPE_IndexRecommendationsIterator,
   TYPE_IsActivatedICIterator,
   TYPE_ActivatedICsIterator,
   TYPE_IsDeclaredCollectionIterator,
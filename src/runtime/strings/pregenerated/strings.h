@@ -32,6 +32,7 @@
 #include "runtime/base/narybase.h"
 #include "zorbautils/checked_vector.h"
 #include "zorbatypes/schema_types.h"
+#include "util/regex.h"
 
 
 namespace zorba {
@@ -880,6 +881,8 @@ public:
   zstring theString; //the remaining string
   zstring thePattern; //the pattern string
   zstring theFlags; //the tokenizing flags
+  unicode::regex theRegex; //the compiled pattern
+  unicode::string theUString; //the string being tokenized, in the regex's encoding
   xs_int start_pos; //the start position
   xs_boolean hasmatched; //flag indicating whether a match was found
 
@@ -80,6 +80,135 @@ static int count_capturing_groups( zstring const &regex ) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * The number of bytes read at a time from the stream of a streamable string.
+ */
+static csize const STREAM_CHUNK_SIZE = 65536;
+
+/**
+ * Checks whether the string value of the given item should be processed by
+ * reading its stream in chunks rather than by materializing it.  Only seekable
+ * streams are read this way: a non-seekable stream can be read only once, and
+ * materializing it keeps its value around for the other uses of the item.  An
+ * item that is already materialized is not read again.
+ *
+ * @param item The item.
+ * @return Returns \c true only if the item's stream should be read.
+ */
+static bool use_stream( store::Item_t const &item ) {
+  return item->isStreamable() && item->isSeekable() && !item->isMaterialized();
+}
+
+/**
+ * Appends at most STREAM_CHUNK_SIZE bytes read from a stream to a buffer.
+ *
+ * @param is The stream to read from.
+ * @param buf The buffer to append to.
+ * @param loc The location to use for errors.
+ * @return Returns the number of bytes appended; 0 only at the end of the
+ * stream.
+ */
+static csize read_chunk( istream &is, string &buf, QueryLoc const &loc ) {
+  csize const old_size = buf.size();
+  buf.resize( old_size + STREAM_CHUNK_SIZE );
+  is.read( &buf[ old_size ], STREAM_CHUNK_SIZE );
+  csize const n = static_cast<csize>( is.gcount() );
+  buf.resize( old_size + n );
+  if ( is.bad() )
+    throw XQUERY_EXCEPTION(
+      zerr::ZOSE0003_STREAM_READ_FAILURE, ERROR_LOC( loc )
+    );
+  return n;
+}
+
+/**
+ * Gets the number of characters of a UTF-8 encoded stream.
+ *
+ * @param is The stream to read.
+ * @param loc The location to use for errors.
+ * @return Returns said number of characters.
+ */
+static zstring::size_type stream_length( istream &is, QueryLoc const &loc ) {
+  string buf;
+  zstring::size_type len = 0;
+  while ( read_chunk( is, buf, loc ) ) {
+    FOR_EACH( string, c, buf )
+      if ( !utf8::is_continuation_byte( *c ) )
+        ++len;
+    buf.clear();
+  }
+  return len;
+}
+
+/**
+ * Checks whether a stream begins with the given string.
+ *
+ * @param is The stream to read.
+ * @param prefix The string.
+ * @param loc The location to use for errors.
+ * @return Returns \c true only if the stream begins with \a prefix.
+ */
+static bool stream_starts_with( istream &is, zstring const &prefix,
+                                QueryLoc const &loc ) {
+  string buf( prefix.size(), '\0' );
+  is.read( &buf[0], prefix.size() );
+  if ( is.bad() )
+    throw XQUERY_EXCEPTION(
+      zerr::ZOSE0003_STREAM_READ_FAILURE, ERROR_LOC( loc )
+    );
+  return static_cast<csize>( is.gcount() ) == prefix.size() &&
+         prefix.compare( 0, prefix.size(), buf.data(), buf.size() ) == 0;
+}
+
+/**
+ * Searches a stream for the first occurrence of a non-empty string, reading
+ * the stream in chunks and keeping in memory only the bytes that may still be
+ * part of a match.
+ *
+ * @param is The stream to search.
+ * @param pattern The string to search for.
+ * @param before If not \c null, the bytes preceding the match are appended to
+ * it; if there is no match, they are the bytes of the whole stream.
+ * @param after If not \c null and there is a match, the bytes following the
+ * match are appended to it.
+ * @param loc The location to use for errors.
+ * @return Returns \c true only if \a pattern was found.
+ */
+static bool stream_find( istream &is, zstring const &pattern, zstring *before,
+                         zstring *after, QueryLoc const &loc ) {
+  ZORBA_ASSERT( !pattern.empty() );
+  csize const keep = pattern.size() - 1;
+  string buf;
+
+  while ( read_chunk( is, buf, loc ) ) {
+    string::size_type const pos =
+      buf.find( pattern.data(), 0, pattern.size() );
+    if ( pos != string::npos ) {
+      if ( before )
+        before->append( buf.data(), pos );
+      if ( after ) {
+        buf.erase( 0, pos + pattern.size() );
+        do {
+          after->append( buf.data(), buf.size() );
+          buf.clear();
+        } while ( read_chunk( is, buf, loc ) );
+      }
+      return true;
+    }
+    if ( buf.size() > keep ) {
+      csize const n = buf.size() - keep;
+      if ( before )
+        before->append( buf.data(), n );
+      buf.erase( 0, n );
+    }
+  }
+  if ( before )
+    before->append( buf.data(), buf.size() );
+  return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 /**
   *______________________________________________________________________
   *
@@ -747,14 +876,23 @@ bool StringLengthIterator::nextImpl(
 {
   store::Item_t item;
   zstring strval;
+  zstring::size_type len;
 
   PlanIteratorState* state;
   DEFAULT_STACK_INIT(PlanIteratorState, state, planState);
 
   if (consumeNext(item, theChildren [0].getp(), planState))
   {
-    item->getStringValue2(strval);
-    STACK_PUSH(GENV_ITEMFACTORY->createInteger(result, xs_integer(utf8::length(strval))), state);
+    if (use_stream(item))
+    {
+      len = stream_length(item->getStream(), loc);
+    }
+    else
+    {
+      item->getStringValue2(strval);
+      len = utf8::length(strval);
+    }
+    STACK_PUSH(GENV_ITEMFACTORY->createInteger(result, xs_integer(len)), state);
   }
   else
   {
@@ -1153,6 +1291,7 @@ bool ContainsIterator::nextImpl(
   store::Item_t item1;
   store::Item_t itemColl;
   bool resBool = false;
+  bool streamArg1 = false;
   zstring arg1;
   zstring arg2;
 
@@ -1161,7 +1300,10 @@ bool ContainsIterator::nextImpl(
 
   if (consumeNext(item0, theChildren[0].getp(), planState ))
   {
-    item0->getStringValue2(arg1);
+    if (theChildren.size() == 2 && use_stream(item0))
+      streamArg1 = true;
+    else
+      item0->getStringValue2(arg1);
   }
 
   if (consumeNext(item1, theChildren[1].getp(), planState ))
@@ -1173,13 +1315,17 @@ bool ContainsIterator::nextImpl(
   {
     STACK_PUSH( GENV_ITEMFACTORY->createBoolean(result, true), state );
   }
-  else if (arg1.empty())
+  else if (arg1.empty() && !streamArg1)
   {
     STACK_PUSH( GENV_ITEMFACTORY->createBoolean(result, false), state );
   }
   else
   {
-    if (theChildren.size() == 2)
+    if (streamArg1)
+    {
+      resBool = stream_find(item0->getStream(), arg2, NULL, NULL, loc);
+    }
+    else if (theChildren.size() == 2)
     {
       resBool = (arg1.find(arg2) != zstring::npos);
     }
@@ -1217,6 +1363,7 @@ bool StartsWithIterator::nextImpl(
   store::Item_t item1;
   store::Item_t itemColl;
   bool resBool = false;
+  bool streamArg1 = false;
   zstring arg1;
   zstring arg2;
 
@@ -1227,7 +1374,10 @@ bool StartsWithIterator::nextImpl(
   {
     if (consumeNext(item0, theChildren[0].getp(), planState ))
     {
-      item0->getStringValue2(arg1);
+      if (theChildren.size() == 2 && use_stream(item0))
+        streamArg1 = true;
+      else
+        item0->getStringValue2(arg1);
     }
 
     if (consumeNext(item1, theChildren[1].getp(), planState ))
@@ -1239,13 +1389,17 @@ bool StartsWithIterator::nextImpl(
     {
       STACK_PUSH( GENV_ITEMFACTORY->createBoolean(result, true), state );
     }
-    else if (arg1.empty())
+    else if (arg1.empty() && !streamArg1)
     {
       STACK_PUSH( GENV_ITEMFACTORY->createBoolean(result, false), state );
     }
     else
     {
-      if (theChildren.size() == 2)
+      if (streamArg1)
+      {
+        resBool = stream_starts_with(item0->getStream(), arg2, loc);
+      }
+      else if (theChildren.size() == 2)
       {
         resBool = (arg1.find(arg2) == 0);
       }
@@ -1348,6 +1502,7 @@ bool SubstringBeforeIterator::nextImpl(
   store::Item_t item1;
   store::Item_t itemColl;
   zstring::size_type index = zstring::npos;
+  bool streamArg1 = false;
   zstring arg1;
   zstring arg2;
   zstring resStr;
@@ -1359,7 +1514,10 @@ bool SubstringBeforeIterator::nextImpl(
   {
     if (consumeNext(item0, theChildren[0].getp(), planState ))
     {
-      item0->getStringValue2(arg1);
+      if (theChildren.size() == 2 && use_stream(item0))
+        streamArg1 = true;
+      else
+        item0->getStringValue2(arg1);
     }
 
     if (consumeNext(item1, theChildren[1].getp(), planState ))
@@ -1367,8 +1525,15 @@ bool SubstringBeforeIterator::nextImpl(
       item1->getStringValue2(arg2);
     }
 
-    if (arg1.empty() || arg2.empty())
+    if ((arg1.empty() && !streamArg1) || arg2.empty())
+    {
+      STACK_PUSH( GENV_ITEMFACTORY->createString(result, resStr), state );
+    }
+    else if (streamArg1)
     {
+      if (!stream_find(item0->getStream(), arg2, &resStr, NULL, loc))
+        resStr.clear();
+
       STACK_PUSH( GENV_ITEMFACTORY->createString(result, resStr), state );
     }
     else
@@ -1416,6 +1581,7 @@ bool SubstringAfterIterator::nextImpl(
   store::Item_t item1;
   store::Item_t itemColl;
   zstring::size_type startPos = zstring::npos;
+  bool streamArg1 = false;
   zstring arg1;
   zstring arg2;
   zstring resStr;
@@ -1427,7 +1593,10 @@ bool SubstringAfterIterator::nextImpl(
   {
     if (consumeNext(item0, theChildren[0].getp(), planState ))
     {
-      item0->getStringValue2(arg1);
+      if (theChildren.size() == 2 && use_stream(item0))
+        streamArg1 = true;
+      else
+        item0->getStringValue2(arg1);
     }
 
     if (consumeNext(item1, theChildren[1].getp(), planState ))
@@ -1435,15 +1604,23 @@ bool SubstringAfterIterator::nextImpl(
       item1->getStringValue2(arg2);
     }
 
-    if (arg1.empty())
+    if (arg1.empty() && !streamArg1)
     {
       STACK_PUSH(GENV_ITEMFACTORY->createString(result, resStr), state);
     }
     else if (arg2.empty())
     {
-      resStr = arg1;
+      if (streamArg1)
+        item0->getStringValue2(resStr);
+      else
+        resStr = arg1;
       STACK_PUSH( GENV_ITEMFACTORY->createString(result, resStr), state );
     }
+    else if (streamArg1)
+    {
+      stream_find(item0->getStream(), arg2, NULL, &resStr, loc);
+      STACK_PUSH(GENV_ITEMFACTORY->createString(result, resStr), state);
+    }
     else
     {
       if (theChildren.size() == 2)
@@ -1702,6 +1879,7 @@ void FnTokenizeIteratorState::reset(PlanState& planState)
 {
   PlanIteratorState::reset(planState);
   theString.clear();
+  theUString = unicode::string();
   start_pos = 0;
   hasmatched = false;
   thePattern.clear();
@@ -1756,18 +1934,28 @@ bool FnTokenizeIterator::nextImpl(
     );
 
 
-  while ((xs_unsignedInt)state->start_pos < state->theString.length ())
+  try
+  {
+    //
+    // The RE and the converted input live in the state so they're compiled and
+    // converted once rather than once per token.
+    //
+    state->theRegex.compile( state->thePattern, state->theFlags );
+    unicode::to_string( state->theString, &state->theUString );
+  }
+  catch(XQueryException& ex)
+  {
+    set_source( ex, loc );
+    throw;
+  }
+
+  while (state->start_pos < state->theUString.length())
   {
     try
     {
-      unicode::regex re;
-      //
-      // The RE needs to be compiled every time due to the weird stack macros.
-      //
-      re.compile( state->thePattern, state->theFlags );
       unicode::string u_token;
-      bool const got_next = re.next_token(
-        state->theString, &state->start_pos, &u_token, &state->hasmatched
+      bool const got_next = state->theRegex.next_token(
+        state->theUString, &state->start_pos, &u_token, &state->hasmatched
       );
       utf8::to_string( u_token, &token );
       if ( !got_next )
@@ -47,6 +47,7 @@ PIV_VISIT_DECL( DebuggerSingletonIterator );
 PIV_VISIT_DECL( DeleteIndexIterator );
 PIV_VISIT_DECL( DeleteIterator );
 PIV_VISIT_DECL( DescendantAxisIterator );
+PIV_VISIT_DECL( DescendantPathIterator );
 PIV_VISIT_DECL( DescendantSelfAxisIterator );
 PIV_VISIT_DECL( DocumentIterator );
 PIV_VISIT_DECL( EitherNodesOrAtomicsIterator );
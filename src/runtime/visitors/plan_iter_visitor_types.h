@@ -45,6 +45,7 @@ class DebuggerSingletonIterator;
 class DeleteIndexIterator;
 class DeleteIterator;
 class DescendantAxisIterator;
+class DescendantPathIterator;
 class DescendantSelfAxisIterator;
 class DivideOperation;
 class DocumentIterator;
@@ -107,6 +107,8 @@ namespace zorba{
 
     class AvailableIndexesIterator;
 
+    class IndexRecommendationsIterator;
+
     class IsActivatedICIterator;
 
     class ActivatedICsIterator;
@@ -894,6 +896,9 @@ public:
     virtual void beginVisit ( const AvailableIndexesIterator& ) = 0;
     virtual void endVisit   ( const AvailableIndexesIterator& ) = 0;
 
+    virtual void beginVisit ( const IndexRecommendationsIterator& ) = 0;
+    virtual void endVisit   ( const IndexRecommendationsIterator& ) = 0;
+
     virtual void beginVisit ( const IsActivatedICIterator& ) = 0;
     virtual void endVisit   ( const IsActivatedICIterator& ) = 0;
 
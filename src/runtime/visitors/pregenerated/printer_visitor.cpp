@@ -333,20 +333,6 @@ void PrinterVisitor::endVisit( const FnCollectionIterator& ) {
 // </FnCollectionIterator>
 
 
-// <ZorbaCollectionIterator>
-void PrinterVisitor::beginVisit( const ZorbaCollectionIterator& a) {
-  thePrinter.startBeginVisit("ZorbaCollectionIterator", ++theId);
-  printCommons( &a, theId );
-  thePrinter.endBeginVisit( theId );
-}
-
-void PrinterVisitor::endVisit( const ZorbaCollectionIterator& ) {
-  thePrinter.startEndVisit();
-  thePrinter.endEndVisit();
-}
-// </ZorbaCollectionIterator>
-
-
 // <ZorbaCollectionNameIterator>
 void PrinterVisitor::beginVisit( const ZorbaCollectionNameIterator& a) {
   thePrinter.startBeginVisit("ZorbaCollectionNameIterator", ++theId);
@@ -473,6 +459,20 @@ void PrinterVisitor::endVisit( const AvailableIndexesIterator& ) {
 // </AvailableIndexesIterator>
 
 
+// <IndexRecommendationsIterator>
+void PrinterVisitor::beginVisit( const IndexRecommendationsIterator& a) {
+  thePrinter.startBeginVisit("IndexRecommendationsIterator", ++theId);
+  printCommons( &a, theId );
+  thePrinter.endBeginVisit( theId );
+}
+
+void PrinterVisitor::endVisit( const IndexRecommendationsIterator& ) {
+  thePrinter.startEndVisit();
+  thePrinter.endEndVisit();
+}
+// </IndexRecommendationsIterator>
+
+
 // <IsActivatedICIterator>
 void PrinterVisitor::beginVisit( const IsActivatedICIterator& a) {
   thePrinter.startBeginVisit("IsActivatedICIterator", ++theId);
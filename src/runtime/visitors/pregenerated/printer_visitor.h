@@ -175,6 +175,9 @@ namespace zorba {
     void beginVisit( const AvailableIndexesIterator& );
     void endVisit  ( const AvailableIndexesIterator& );
 
+    void beginVisit( const IndexRecommendationsIterator& );
+    void endVisit  ( const IndexRecommendationsIterator& );
+
     void beginVisit( const IsActivatedICIterator& );
     void endVisit  ( const IsActivatedICIterator& );
 
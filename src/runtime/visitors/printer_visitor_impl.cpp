@@ -267,6 +267,28 @@ DEF_AXIS_VISIT( PrecedingReverseAxisIterator )
 DEF_AXIS_VISIT( RSiblingAxisIterator )
 DEF_AXIS_VISIT( SelfAxisIterator )
 
+void PrinterVisitor::beginVisit( DescendantPathIterator const &i ) {
+  thePrinter.startBeginVisit( "DescendantPathIterator", ++theId );
+  printCommons( &i, theId );
+
+  std::ostringstream steps;
+  const std::vector<AxisIteratorHelper>& s = i.getSteps();
+  for ( size_t n = 0; n < s.size(); ++n ) {
+    if ( n > 0 )
+      steps << '/';
+    if ( s[n].getQName() != 0 )
+      steps << s[n].getQName()->show().str();
+    else if ( s[n].getTestKind() == match_name_test )
+      steps << '*';
+    else
+      steps << toString( s[n].getTestKind() );
+  }
+  thePrinter.addAttribute( "steps", steps.str() );
+
+  thePrinter.endBeginVisit( theId );
+}
+DEF_END_VISIT( DescendantPathIterator )
+
 #define DEF_OP_VISIT(CLASS,OP)                              \
   void PrinterVisitor::beginVisit( CLASS<OP> const &i ) {   \
     thePrinter.startBeginVisit( #CLASS "_" #OP , ++theId ); \
@@ -369,6 +391,25 @@ DEF_INSERT_NODES_VISIT( ZorbaInsertLastIterator )
 
 ////////// special cases //////////////////////////////////////////////////////
 
+void PrinterVisitor::beginVisit( ZorbaCollectionIterator const &i ) {
+  thePrinter.startBeginVisit( "ZorbaCollectionIterator", ++theId );
+  const std::vector<store::Item_t> path( i.getFilterPath() );
+  if ( !path.empty() ) {
+    std::ostringstream steps;
+    for ( size_t n = 0; n < path.size(); ++n ) {
+      if ( n > 0 )
+        steps << '/';
+      steps << path[n]->show().str();
+    }
+    thePrinter.addAttribute( "filter-path", steps.str() );
+    if ( i.filterHasValue() )
+      thePrinter.addAttribute( "filter-value", i.getFilterValue().str() );
+  }
+  printCommons( &i, theId );
+  thePrinter.endBeginVisit( theId );
+}
+DEF_END_VISIT( ZorbaCollectionIterator )
+
 void PrinterVisitor::beginVisit( AttributeIterator const &i ) {
   thePrinter.startBeginVisit( "AttributeIterator", ++theId );
   if ( i.getQName() )
@@ -649,6 +690,8 @@ void PrinterVisitor::beginVisit( PromoteIterator const &i ) {
   ostringstream lStream;
   TypeOps::serialize( lStream, *i.thePromoteType );
   thePrinter.addAttribute( "type", lStream.str() );
+  if ( i.theAtomize )
+    thePrinter.addAttribute( "atomize", "true" );
   printCommons( &i, theId );
   thePrinter.endBeginVisit( theId );
 }
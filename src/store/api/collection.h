@@ -19,10 +19,67 @@
 #include <zorba/config.h>
 #include "zorbatypes/schema_types.h"
 #include "store/api/shared_types.h"
+#include "store/api/item.h"
 
 namespace zorba { namespace store {
 
 
+/*******************************************************************************
+  A simple predicate over the members of a collection that a store may evaluate
+  while scanning the collection, before the members are handed to the query
+  runtime.
+
+  thePath : The steps that select the values to test, starting at a member.
+            An xs:QName step selects the child elements with that name; an
+            xs:string step selects the value of an object pair with that key.
+  theHasValue :
+            If false, the predicate is an existence test: it is true if the
+            path selects at least one value.
+  theValue :
+            If theHasValue is true, the predicate is true if the string value
+            of at least one selected value is equal (by codepoint) to theValue.
+
+  A filter is only a hint: a store may return members that do not satisfy it
+  (for example, members whose values are typed), so the runtime must still
+  evaluate the original predicate on every returned member. A store must never
+  drop a member for which the predicate could be true.
+********************************************************************************/
+class CollectionFilter
+{
+public:
+  std::vector<Item_t> thePath;
+  bool                theHasValue;
+  zstring             theValue;
+
+public:
+  CollectionFilter() : theHasValue(false) { }
+};
+
+
+/*******************************************************************************
+  Statistics gathered by a store about the filtered scans of a collection, per
+  filter path and kind (the filter values are not distinguished).
+
+  theScans    : The number of filtered scans.
+  theScanned  : The number of members tested against the filter.
+  theSelected : The number of members returned by the scans. Since a filter is
+                only a hint (see CollectionFilter), this is an upper bound on
+                the number of members that actually satisfy the predicate.
+********************************************************************************/
+class CollectionFilterStats
+{
+public:
+  CollectionFilter theFilter;
+  uint64_t         theScans;
+  uint64_t         theScanned;
+  uint64_t         theSelected;
+
+public:
+  CollectionFilterStats() : theScans(0), theScanned(0), theSelected(0) { }
+};
+
+
+
 class Collection : public SyncedRCObject
 {
 public:
@@ -54,6 +111,26 @@ public:
       const xs_integer& aSkip = numeric_consts<xs_integer>::zero(),
       const zstring& aStart = "") = 0;
 
+  /**
+   * Get an iterator over the nodes of the collection that may satisfy the
+   * given filter. A store that cannot evaluate filters may ignore the filter
+   * and return all the nodes, as getIterator() does.
+   *
+   * @param aFilter The filter. It must stay alive while the iterator is used.
+   * @return Iterator
+   */
+  virtual Iterator_t getFilteredIterator(const CollectionFilter& aFilter) = 0;
+
+  /**
+   * Get the statistics gathered about the filtered scans of the collection.
+   * The default implementation does not gather any.
+   *
+   * @param aStats The statistics, one entry per filter path and kind.
+   */
+  virtual void getFilterStats(std::vector<CollectionFilterStats>& aStats) const
+  {
+  }
+
   /**
    * Get the node at the given position in the collection.
    * 
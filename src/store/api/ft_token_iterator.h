@@ -17,6 +17,8 @@
 #ifndef ZORBA_FT_TOKEN_ITERATOR_H
 #define ZORBA_FT_TOKEN_ITERATOR_H
 
+#include <vector>
+
 #include "zorbatypes/ft_token.h"
 #include "zorbatypes/rchandle.h"
 
@@ -28,6 +30,7 @@ namespace zorba {
 class ZORBA_DLL_PUBLIC FTTokenIterator : public SimpleRCObject {
 public:
   typedef unsigned index_t;
+  typedef std::vector<index_t> index_list;
 
   /**
    * A %Mark holds the position state of an iterator.
@@ -90,6 +93,38 @@ public:
    */
   virtual void reset() = 0;
 
+  /**
+   * Sets the current position to the token having the given index.
+   *
+   * @param i The index of the token in [begin(),end()].
+   */
+  virtual void seek( index_t i ) {
+    reset();
+    for ( index_t j = begin(); j < i; ++j )
+      next();
+  }
+
+  /**
+   * Finds the tokens whose value, modified in the given way, is equal to the
+   * given value.  Iterators over tokens that have been indexed can implement
+   * this to avoid having every token compared.
+   *
+   * @param value The value to find.
+   * @param selector The "bit-wise or" of FTToken::Selectors to modify each
+   * token's value by before comparing it; ignored if \a stemmer is not null.
+   * @param stemmer The stemmer to stem each token's value by before comparing
+   * it, if any.
+   * @param lang The language to use for tokens that don't have one.
+   * @param result A pointer to the list to receive the indices, in ascending
+   * order, of the tokens in [begin(),end()) that match.
+   * @return Returns \c false only if this iterator doesn't support finding
+   * tokens (in which case the caller has to compare every token itself).
+   */
+  virtual bool find( FTToken::string_t const &value, int selector,
+                     FTToken::Stemmer const *stemmer,
+                     locale::iso639_1::type lang, index_list *result ) {
+    return false;
+  }
 };
 
 typedef rchandle<FTTokenIterator> FTTokenIterator_t;
@@ -619,6 +619,20 @@ public:
   virtual bool
   isRecursive() const;
 
+  /**
+   *  Get an iterator over the descendant elements of this node whose name is
+   *  equal to the given qname, in document order.
+   *
+   * Note: This function is used purely for enabling certain optimizations in
+   * the query processor. A store that cannot answer it cheaply (e.g. from an
+   * index of element names) should return NULL, in which case the query
+   * processor navigates the descendants itself.
+   *
+   *  @return The iterator, or NULL.
+   */
+  virtual Iterator_t
+  getDescendantElements(const Item* name) const;
+
   /** Accessor for document node
    *  @return  uri?
    */
@@ -975,6 +989,14 @@ public:
    */
   virtual bool isSeekable() const;
 
+  /**
+   * Checks whether the item's content is streamable and has already been
+   * read from the stream and kept in memory.
+   *
+   * @return true only if it is.
+   */
+  virtual bool isMaterialized() const;
+
   /*
    * Ensures that the underlying stream is seekable.
    */
@@ -64,7 +64,10 @@ private:
                                 // nodes will not have their parent link set to the 
                                 // the document node. This is used by the parse-fragment
                                 // functions.
-                               
+
+  bool theInternValues;         // Default true. If set, repeated short text and
+                                // attribute values of a document share a single
+                                // string representation.
 
 public:
   LoadProperties()
@@ -89,7 +92,8 @@ public:
     theNoCDATA(false),
     theNoXIncludeNodes(false),
     theNoNetworkAccess (false),
-    theCreateDocParentLink(true)
+    theCreateDocParentLink(true),
+    theInternValues(true)
   {
   }
 
@@ -118,6 +122,7 @@ public:
     theNoCDATA = false;
     theNoXIncludeNodes = false;
     theNoNetworkAccess  = false;
+    theInternValues = true;
   }
 
   /**
@@ -350,6 +355,16 @@ public:
     return theNoNetworkAccess ;
   }
 
+  // theInternValues
+  void setInternValues(bool aInternValues)
+  {
+    theInternValues = aInternValues;
+  }
+  bool getInternValues() const
+  {
+    return theInternValues;
+  }
+
   /**
    * @brief Return a libxml2 options bit-field based, suitable for using
    * while using libxml2 to parse XML. The following members of this
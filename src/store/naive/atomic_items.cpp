@@ -21,6 +21,7 @@
 
 #include <zorba/internal/unique_ptr.h>
 #include <zorba/util/base64_util.h>
+#include <zorba/util/hexbinary_util.h>
 
 #include "diagnostics/assert.h"
 #include "diagnostics/xquery_diagnostics.h"
@@ -595,7 +596,10 @@ store::Item* UntypedAtomicItem::getType() const
 
 uint32_t UntypedAtomicItem::hash(long timezone, const XQPCollator* aCollation) const
 {
-  return utf8::hash(theValue);
+  if (theHash == 0)
+    theHash = utf8::hash(theValue);
+
+  return theHash;
 }
 
 
@@ -1928,7 +1932,14 @@ store::Item* StringItem::getType() const
 
 uint32_t StringItem::hash(long timezone, const XQPCollator* aCollation) const
 {
-  return utf8::hash(theValue, aCollation);
+  // Only the collation-independent hash code is cached.
+  if (aCollation != NULL && !aCollation->doMemCmp())
+    return utf8::hash(theValue, aCollation);
+
+  if (theHash == 0)
+    theHash = utf8::hash(theValue);
+
+  return theHash;
 }
 
 
@@ -2153,6 +2164,13 @@ bool StreamableStringItem::isSeekable() const
   return theIsSeekable;
 }
 
+
+bool StreamableStringItem::isMaterialized() const
+{
+  return theIsMaterialized;
+}
+
+
 void StreamableStringItem::ensureSeekable()
 {
   if (!theIsMaterialized && !theIsSeekable && theIsConsumed)
@@ -3554,11 +3572,7 @@ void Base64BinaryItem::appendStringValue(zstring& buf) const
   if (theIsEncoded)
     buf.insert(buf.size(), &theValue[0], theValue.size());
   else
-  {
-    std::vector<char> encoded;
-    base64::encode( &theValue[0], theValue.size(), &encoded );
-    buf.insert(buf.size(), &encoded[0], encoded.size());
-  }
+    base64::encode(&theValue[0], theValue.size(), &buf);
 }
 
 
@@ -3662,6 +3676,13 @@ bool StreamableBase64BinaryItem::isSeekable() const
   return theIsSeekable;
 }
 
+
+bool StreamableBase64BinaryItem::isMaterialized() const
+{
+  return theIsMaterialized;
+}
+
+
 void StreamableBase64BinaryItem::ensureSeekable()
 {
   if (!theIsMaterialized && !theIsSeekable && theIsConsumed)
@@ -3757,25 +3778,22 @@ void StreamableBase64BinaryItem::materialize() const
     {
       return;
     }
-    s->theValue.reserve(static_cast<std::vector<char>::size_type>(len));
-    char buf[1024];
-    while (lStream.good())
-    {
-      lStream.read(buf, 1024);
-      s->theValue.insert(s->theValue.end(), buf, buf + lStream.gcount());
-    }
+    // read straight into the value rather than through a bounce buffer
+    s->theValue.resize(static_cast<std::vector<char>::size_type>(len));
+    lStream.read(&s->theValue[0], len);
+    s->theValue.resize(
+      static_cast<std::vector<char>::size_type>(lStream.gcount()));
   }
   else
   {
-    char buf[4048];
+    // let the vector grow geometrically: reserving exactly the new size on
+    // every chunk made materializing a large stream quadratic
+    char buf[16384];
     while (lStream.good())
     {
-      lStream.read(buf, 4048);
+      lStream.read(buf, sizeof buf);
       if (lStream.gcount() > 0)
-      {
-        s->theValue.reserve(static_cast<std::vector<char>::size_type>(s->theValue.size() + lStream.gcount()));
         s->theValue.insert(s->theValue.end(), buf, buf + lStream.gcount());
-      }
     }
   }
 }
@@ -3862,11 +3880,7 @@ void HexBinaryItem::appendStringValue(zstring& buf) const
   if (theIsEncoded)
     buf.insert(buf.size(), &theValue[0], theValue.size());
   else
-  {
-    Base16::value_type encoded;
-    Base16::encode(theValue, encoded);
-    buf.insert(buf.size(), &encoded[0], encoded.size());
-  }
+    hexbinary::encode(&theValue[0], theValue.size(), &buf);
 }
 
 
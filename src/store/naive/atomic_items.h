@@ -262,6 +262,9 @@ public:
 
 /*******************************************************************************
   class UntypedAtomicItem
+
+  theHash : The hash code of theValue for byte-wise comparison, computed on
+            the first call to hash() that needs it; 0 if not computed yet.
 ********************************************************************************/
 class UntypedAtomicItem : public AtomicItem
 {
@@ -269,17 +272,19 @@ class UntypedAtomicItem : public AtomicItem
   friend class AtomicItem;
 
 protected:
-  zstring theValue;
+  zstring          theValue;
+  mutable uint32_t theHash;
 
 protected:
   UntypedAtomicItem(store::SchemaTypeCode t, zstring& value)
     :
-    AtomicItem(t)
+    AtomicItem(t),
+    theHash(0)
   {
     theValue.take(value);
   }
 
-  UntypedAtomicItem(store::SchemaTypeCode t) : AtomicItem(t) {}
+  UntypedAtomicItem(store::SchemaTypeCode t) : AtomicItem(t), theHash(0) {}
 
 public:
   bool castToUri(store::Item_t& result) const;
@@ -877,6 +882,9 @@ protected:
 
 /*******************************************************************************
   class StringItem
+
+  theHash : The hash code of theValue for byte-wise comparison, computed on
+            the first call to hash() that needs it; 0 if not computed yet.
 ********************************************************************************/
 class StringItem : public AtomicItem
 {
@@ -886,17 +894,19 @@ class StringItem : public AtomicItem
 #endif /* ZORBA_NO_FULL_TEXT */
 
 protected:
-  zstring theValue;
+  zstring          theValue;
+  mutable uint32_t theHash;
 
 protected:
   StringItem(store::SchemaTypeCode t, zstring& value)
     :
-    AtomicItem(t)
+    AtomicItem(t),
+    theHash(0)
   {
     theValue.take(value);
   }
 
-  StringItem(store::SchemaTypeCode t) : AtomicItem(t) {}
+  StringItem(store::SchemaTypeCode t) : AtomicItem(t), theHash(0) {}
 
 public:
   size_t alloc_size() const;
@@ -985,6 +995,8 @@ public:
 
   bool isSeekable() const;
 
+  bool isMaterialized() const;
+
   void ensureSeekable();
 
   std::istream& getStream();
@@ -2419,6 +2431,8 @@ public:
 
   bool isSeekable() const;
 
+  bool isMaterialized() const;
+
   void ensureSeekable();
 
   std::istream& getStream();
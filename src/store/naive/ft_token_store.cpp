@@ -15,6 +15,8 @@
  */
 #include "stdafx.h"
 
+#include <algorithm>
+
 #include "ft_token_store.h"
 
 using namespace std;
@@ -26,6 +28,41 @@ FTTokenStore::range_type const& FTTokenStore::empty_range() {
   return empty;
 }
 
+void FTTokenStore::findTokens( FTToken::string_t const &value, int selector,
+                               FTToken::Stemmer const *stemmer,
+                               locale::iso639_1::type lang,
+                               size_type begin, size_type end,
+                               FTTokenIterator::index_list *result ) {
+  result->clear();
+
+  index_key_type const key(
+    stemmer ? -1 : selector, stemmer ? stemmer->identity() : nullptr, lang
+  );
+
+  SYNC_CODE( AutoMutex const lock( &index_mutex_ ); )
+  inverted_index &index = index_map_[ key ];
+
+  if ( index.terms.empty() || index.indexed_size != doc_tokens_.size() ) {
+    index.terms.clear();
+    for ( size_type i = 0; i < doc_tokens_.size(); ++i ) {
+      FTToken const &t = doc_tokens_[i];
+      FTToken::string_t const &t_value =
+        stemmer ? t.value( *stemmer, lang ) : t.value( selector, lang );
+      index.terms[ t_value ].push_back( i );
+    }
+    index.indexed_size = doc_tokens_.size();
+  }
+
+  term_map_type::const_iterator const i = index.terms.find( value );
+  if ( i != index.terms.end() ) {
+    postings_type const &postings = i->second;
+    postings_type::const_iterator const
+      first = lower_bound( postings.begin(), postings.end(), begin ),
+      last  = lower_bound( first, postings.end(), end );
+    result->assign( first, last );
+  }
+}
+
 } // namespace zorba
 
 /*
@@ -23,7 +23,12 @@
 
 #include <zorba/internal/cxx_util.h>
 
+#include "common/common.h"
+#include "store/api/ft_token_iterator.h"
+#include "util/hash/hash.h"
+#include "util/unordered_map.h"
 #include "zorbatypes/ft_token.h"
+#include "zorbautils/mutex.h"
 
 namespace zorba { 
 
@@ -37,6 +42,11 @@ public:
 
   typedef void const* key_type;
   typedef std::pair<size_type,size_type> range_type;
+
+  /**
+   * The ascending indices of the document tokens having a given value.
+   */
+  typedef std::vector<size_type> postings_type;
 private:
   typedef std::map<key_type,range_type> doc_map_type;
   typedef std::map<key_type,container_type> att_map_type;
@@ -84,6 +94,33 @@ public:
     doc_map_[ key ] = std::make_pair( begin, end );
   }
 
+  ////////// inverted index ///////////////////////////////////////////////////
+
+  /**
+   * Finds the indices of the document tokens in [begin,end) whose value,
+   * modified in the given way, is equal to the given value.  The inverted
+   * index for each distinct way of modifying values is built the first time
+   * it's needed and kept until the tokens change.
+   *
+   * Note that the index covers only this XML document: finding the documents
+   * of a collection that contain a value still means tokenizing each of them.
+   *
+   * @param value The value to find.
+   * @param selector The "bit-wise or" of FTToken::Selectors to modify each
+   * token's value by; ignored if \a stemmer is not null.
+   * @param stemmer The stemmer to stem each token's value by, if any.
+   * @param lang The language to use for tokens that don't have one.
+   * @param begin The index of the first token to consider.
+   * @param end One past the index of the last token to consider.
+   * @param result A pointer to the list to receive the indices in ascending
+   * order.
+   */
+  void findTokens( FTToken::string_t const &value, int selector,
+                   FTToken::Stemmer const *stemmer,
+                   locale::iso639_1::type lang,
+                   size_type begin, size_type end,
+                   FTTokenIterator::index_list *result );
+
   ////////// attribute tokens /////////////////////////////////////////////////
 
   /**
@@ -117,16 +154,54 @@ public:
     doc_tokens_.clear();
     doc_map_.clear();
     att_map_.clear();
+    SYNC_CODE( AutoMutex const lock( &index_mutex_ ); )
+    index_map_.clear();
   }
 
   /////////////////////////////////////////////////////////////////////////////
 
 private:
+  typedef std::unordered_map<FTToken::string_t,postings_type> term_map_type;
+
+  struct inverted_index {
+    size_type indexed_size;             // # of doc tokens when built
+    term_map_type terms;
+  };
+
+  /**
+   * The key of an inverted index: the selector (or -1 for stemming), the
+   * identity of the stemmer (if any), and the language.
+   */
+  struct index_key_type {
+    int selector;
+    void const *stemmer;
+    int lang;
+
+    index_key_type( int sel, void const *stem, int l ) :
+      selector( sel ), stemmer( stem ), lang( l )
+    {
+    }
+
+    bool operator<( index_key_type const &k ) const {
+      if ( selector != k.selector )
+        return selector < k.selector;
+      if ( stemmer != k.stemmer )
+        return std::less<void const*>()( stemmer, k.stemmer );
+      return lang < k.lang;
+    }
+  };
+  typedef std::map<index_key_type,inverted_index> index_map_type;
+
   static range_type const& empty_range();
 
   container_type doc_tokens_;
   doc_map_type doc_map_;
   att_map_type att_map_;
+  index_map_type index_map_;
+
+  // XML trees, hence their token stores, are shared by the queries running
+  // in different threads, so the inverted indexes are built under a lock.
+  SYNC_CODE( Mutex index_mutex_; )
 };
 
 } // namespace zorba
@@ -17,7 +17,7 @@
 #define ZORBA_SIMPLESTORE_NODE_POINTER_HASHMAP
 
 #include "zorbautils/hashfun.h"
-#include "zorbautils/hashmap.h"
+#include "zorbautils/open_hashmap.h"
 
 namespace zorba
 {
@@ -52,14 +52,14 @@ public:
   Equality is based on the Item::equals() method.
 *******************************************************************************/
 template <class V>
-class NodePointerHashMap : public HashMap<const XmlNode*,
-                                          V,
-                                          NodePointerHashMapCmp>
+class NodePointerHashMap : public OpenHashMap<const XmlNode*,
+                                              V,
+                                              NodePointerHashMapCmp>
 {
 public:
   NodePointerHashMap(ulong size, bool sync) 
     :
-    HashMap<const XmlNode*, V, NodePointerHashMapCmp>(size, sync)
+    OpenHashMap<const XmlNode*, V, NodePointerHashMapCmp>(size, sync)
   {
   }
 };
@@ -89,14 +89,14 @@ public:
   Equality is based on the Item::equals() method.
 *******************************************************************************/
 template <class V>
-class ItemPointerHashMap : public HashMap<const store::Item*,
-                                          V,
-                                          ItemPointerHashMapCmp>
+class ItemPointerHashMap : public OpenHashMap<const store::Item*,
+                                              V,
+                                              ItemPointerHashMapCmp>
 {
 public:
   ItemPointerHashMap(ulong size, bool sync) 
     :
-    HashMap<const store::Item*, V, ItemPointerHashMapCmp>(size, sync)
+    OpenHashMap<const store::Item*, V, ItemPointerHashMapCmp>(size, sync)
   {
   }
 };
@@ -959,6 +959,12 @@ bool Item::isRecursive() const
 }
 
 
+Iterator_t Item::getDescendantElements(const Item* /*name*/) const
+{
+  return NULL;
+}
+
+
 void Item::getDocumentURI(zstring& uri) const
 {
   throw ZORBA_EXCEPTION(
@@ -1486,6 +1492,11 @@ bool Item::isSeekable() const
   return false;
 }
 
+bool Item::isMaterialized() const
+{
+  return false;
+}
+
 void
 Item::ensureSeekable()
 {
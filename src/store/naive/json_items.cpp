@@ -596,6 +596,23 @@ store::Item_t SimpleJSONObject::getObjectValue(const store::Item_t& aKey) const
 }
 
 
+/******************************************************************************
+  Like getObjectValue(), but without materializing the key or ref-counting the
+  value.
+*******************************************************************************/
+store::Item* SimpleJSONObject::findObjectValue(const char* aKey) const
+{
+  Keys::const_iterator lIter = theKeys.find(aKey);
+
+  if (lIter == theKeys.end())
+  {
+    return NULL;
+  }
+
+  return thePairs[lIter->second].second;
+}
+
+
 /******************************************************************************
 
 *******************************************************************************/
@@ -256,6 +256,10 @@ public:
 
   store::Item_t getObjectValue(const store::Item_t& aKey) const;
 
+  // simplestore methods
+
+  store::Item* findObjectValue(const char* aKey) const;
+
   xs_integer getNumObjectPairs() const;
 
   store::Item* copy(
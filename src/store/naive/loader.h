@@ -26,6 +26,7 @@
 #include "ordpath.h"
 
 #include "zorbautils/stack.h"
+#include "zorbautils/string_dictionary.h"
 #include "runtime/parsing_and_serializing/fragment_istream.h"
 
 
@@ -124,6 +125,12 @@ public:
                  and the endElement and endDocument methods will remove these
                  children from the stack and link them with N.
 
+  theValueDictionary : If the interning of values is enabled in the load
+                 properties, the text and attribute values of the document
+                 being loaded are looked up in this dictionary, so that equal
+                 short values share their string representation. It is
+                 cleared after each document.
+
 ********************************************************************************/
 class FastXmlLoader : public XmlLoader
 {
@@ -151,6 +158,8 @@ protected:
   zorba::Stack<PathStepInfo>       thePathStack;
   std::stack<NsBindingsContext*>   theBindingsStack;
 
+  StringDictionary                 theValueDictionary;
+
 #ifdef DATAGUIDE
   zorba::Stack<ElementGuideNode*>  theGuideStack;
 #endif
@@ -178,6 +187,8 @@ protected:
 
   void* getElementNode();
 
+  void getValue(const char* str, csize len, zstring& value);
+
 public:
   static void	startDocument(void * ctx);
 
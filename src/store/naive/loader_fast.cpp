@@ -242,6 +242,20 @@ void FastXmlLoader::setRoot(XmlNode* root)
 }
 
 
+/*******************************************************************************
+  Return in "value" a string equal to the given text or attribute value,
+  sharing its representation with an equal value seen before in the same
+  document, if possible.
+********************************************************************************/
+void FastXmlLoader::getValue(const char* str, csize len, zstring& value)
+{
+  if (theLoadProperties.getInternValues())
+    theValueDictionary.intern(str, len, value);
+  else
+    value.assign(str, len);
+}
+
+
 /*******************************************************************************
   Method called to do cleanup in case of errors.
 ********************************************************************************/
@@ -269,6 +283,8 @@ void FastXmlLoader::abortload()
 
   thePathStack.clear();
 
+  theValueDictionary.clear();
+
 #ifdef DATAGUIDE
   if(!theGuideStack.empty())
   {
@@ -308,6 +324,8 @@ void FastXmlLoader::reset()
   theOrdPath.init();
   theRootNode = NULL;
 
+  theValueDictionary.clear();
+
   if (!theNodeStack.empty())
     theNodeStack.pop();
 
@@ -808,7 +826,8 @@ void FastXmlLoader::startElement(
         store::Item_t qname;
         qnpool.insert(qname, uri, prefix, lname);
 
-        zstring value(valueBegin, valueEnd);
+        zstring value;
+        loader.getValue(valueBegin, valueEnd - valueBegin, value);
         store::Item_t typedValue;
         GET_STORE().getItemFactory()->createUntypedAtomic(typedValue, value);
 
@@ -1020,7 +1039,8 @@ void FastXmlLoader::characters(void * ctx, const xmlChar * ch, int len)
   try
   {
     const char* charp = reinterpret_cast<const char*>(ch);
-    zstring content(charp, len);
+    zstring content;
+    loader.getValue(charp, len, content);
 
     TextNode* textNode = GET_STORE().getNodeFactory().createTextNode(content);
 
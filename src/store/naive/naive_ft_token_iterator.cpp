@@ -27,7 +27,7 @@ namespace zorba {
 
 NaiveFTTokenIterator::NaiveFTTokenIterator( container_type const &tokens,
                                             index_t begin, index_t end ) :
-  tokens_( &tokens ), begin_( begin ), end_( end ),
+  tokens_( &tokens ), token_store_( nullptr ), begin_( begin ), end_( end ),
   must_delete_( false )
 {
   init();
@@ -35,13 +35,24 @@ NaiveFTTokenIterator::NaiveFTTokenIterator( container_type const &tokens,
 }
 
 NaiveFTTokenIterator::NaiveFTTokenIterator( container_type const *tokens ) :
-  tokens_( tokens ), begin_( 0 ), end_( (index_t)tokens->size() ),
+  tokens_( tokens ), token_store_( nullptr ),
+  begin_( 0 ), end_( (index_t)tokens->size() ),
   must_delete_( true )
 {
   init();
   pos_ = begin_;
 }
 
+NaiveFTTokenIterator::NaiveFTTokenIterator( FTTokenStore &token_store,
+                                            index_t begin, index_t end ) :
+  tokens_( &token_store.getDocumentTokens() ), token_store_( &token_store ),
+  begin_( begin ), end_( end ),
+  must_delete_( false )
+{
+  init();
+  pos_ = begin_;
+}
+
 NaiveFTTokenIterator::~NaiveFTTokenIterator() {
   if ( must_delete_ )
     delete tokens_;
@@ -80,5 +91,22 @@ void NaiveFTTokenIterator::reset() {
   pos_ = begin_;
 }
 
+void NaiveFTTokenIterator::seek( index_t i ) {
+  ZORBA_ASSERT( i >= begin_ && i <= end_ );
+  pos_ = i;
+}
+
+bool NaiveFTTokenIterator::find( FTToken::string_t const &value, int selector,
+                                 FTToken::Stemmer const *stemmer,
+                                 locale::iso639_1::type lang,
+                                 index_list *result ) {
+  if ( !token_store_ )
+    return false;
+  token_store_->findTokens(
+    value, selector, stemmer, lang, begin_, end_, result
+  );
+  return true;
+}
+
 } // namespace zorba
 /* vim:set et sw=2 ts=2: */
@@ -31,6 +31,14 @@ public:
 
   NaiveFTTokenIterator( container_type const&, index_t begin, index_t end );
   NaiveFTTokenIterator( container_type const* );
+
+  /**
+   * Constructs a %NaiveFTTokenIterator over the [begin,end) range of the
+   * document tokens of the given token store.  Such an iterator can find
+   * tokens by value using the store's inverted index.
+   */
+  NaiveFTTokenIterator( FTTokenStore&, index_t begin, index_t end );
+
   ~NaiveFTTokenIterator();
 
   index_t begin() const;
@@ -40,6 +48,9 @@ public:
   Mark_t pos() const;
   void pos( Mark_t const& );
   void reset();
+  void seek( index_t );
+  bool find( FTToken::string_t const&, int, FTToken::Stemmer const*,
+             locale::iso639_1::type, index_list* );
 
 private:
   struct LocalMark : Mark {
@@ -48,6 +59,7 @@ private:
   };
 
   container_type const *tokens_;
+  FTTokenStore *const token_store_;
   index_t const begin_, end_;
   index_t pos_;
   bool const must_delete_;
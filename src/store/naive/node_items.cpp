@@ -73,11 +73,13 @@ XmlTree::XmlTree()
   theDataGuideRootNode(NULL),
 #endif
   theIsValidated(false),
-  theIsRecursive(false)
+  theIsRecursive(false),
 #ifndef EMBEDED_TYPE
-  ,
-  theTypesMap(NULL)
+  theTypesMap(NULL),
 #endif
+  theElementNames(NULL),
+  theNumNameLookups(0),
+  theElementNamesFailed(false)
 {
 }
 
@@ -95,11 +97,13 @@ XmlTree::XmlTree(XmlNode* root, const TreeId& id)
   theDataGuideRootNode(NULL),
 #endif
   theIsValidated(false),
-  theIsRecursive(false)
+  theIsRecursive(false),
 #ifndef EMBEDED_TYPE
-  ,
-  theTypesMap(NULL)
+  theTypesMap(NULL),
 #endif
+  theElementNames(NULL),
+  theNumNameLookups(0),
+  theElementNamesFailed(false)
 {
 }
 
@@ -136,6 +140,8 @@ void XmlTree::destroy() throw()
     delete theTypesMap;
 #endif
 
+  delete theElementNames;
+
   delete this;
 }
 
@@ -149,6 +155,114 @@ void XmlTree::free()
 }
 
 
+/*******************************************************************************
+  Build the element-name index of this tree: for each distinct element name, the
+  elements of the tree having that name, in document order. Return false, and
+  build nothing, if the tree contains connector nodes, i.e., if some of its
+  nodes belong to other trees.
+********************************************************************************/
+bool XmlTree::buildElementNames()
+{
+  if (theRootNode == NULL ||
+      (theRootNode->getNodeKind() != store::StoreConsts::documentNode &&
+       theRootNode->getNodeKind() != store::StoreConsts::elementNode))
+    return false;
+
+  std::unique_ptr<ElementNameIndex> index(new ElementNameIndex);
+
+  std::vector<InternalNode*> stack;
+  stack.push_back(static_cast<InternalNode*>(theRootNode));
+
+  while (!stack.empty())
+  {
+    InternalNode* node = stack.back();
+    stack.pop_back();
+
+    if (node->getNodeKind() == store::StoreConsts::elementNode)
+    {
+      const store::Item* name =
+      static_cast<QNameItem*>(node->getNodeName())->getNormalized();
+      ElementNameList_t& list = (*index)[name];
+
+      if (list == NULL)
+        list = new ElementNameList;
+
+      list->theNodes.push_back(node);
+    }
+
+    // Push the children in reverse order, so that they are visited in
+    // document order.
+    InternalNode::const_reverse_iterator ite = node->childrenRBegin();
+    InternalNode::const_reverse_iterator end = node->childrenREnd();
+
+    for (; ite != end; ++ite)
+    {
+      XmlNode* child = *ite;
+
+      if (child->isConnectorNode())
+        return false;
+
+      if (child->getNodeKind() == store::StoreConsts::elementNode)
+        stack.push_back(static_cast<InternalNode*>(child));
+    }
+  }
+
+  theElementNames = index.release();
+  return true;
+}
+
+
+/*******************************************************************************
+  Put in result the document-ordered list of the elements of this tree that have
+  the given (normalized) name, or NULL if there are none. Return false if the
+  element-name index is not available, in which case the caller must navigate
+  the tree itself.
+
+  The index is built by the second lookup on a tree, so that trees that are
+  navigated only once do not pay for it.
+********************************************************************************/
+bool XmlTree::findElements(const store::Item* name, ElementNameList_t& result)
+{
+  SYNC_CODE(AutoMutex lock(&theElementNamesMutex);)
+
+  if (theElementNames == NULL)
+  {
+    if (theElementNamesFailed || ++theNumNameLookups < 2)
+      return false;
+
+    if (!buildElementNames())
+    {
+      theElementNamesFailed = true;
+      return false;
+    }
+  }
+
+  ElementNameIndex::const_iterator ite = theElementNames->find(name);
+
+  result = (ite == theElementNames->end() ? NULL : ite->second);
+  return true;
+}
+
+
+/*******************************************************************************
+  Called after every structural update of the tree.
+********************************************************************************/
+void XmlTree::invalidateElementNames()
+{
+  // Trees are not updated while being navigated by other threads, so this
+  // check, which keeps node construction cheap, needs no lock.
+  if (theElementNames == NULL && theNumNameLookups == 0)
+    return;
+
+  SYNC_CODE(AutoMutex lock(&theElementNamesMutex);)
+
+  delete theElementNames;
+  theElementNames = NULL;
+  theNumNameLookups = 0;
+  theElementNamesFailed = false;
+}
+
+
 #ifndef EMBEDED_TYPE
 
 /*******************************************************************************
@@ -1687,6 +1801,22 @@ csize InternalNode::findChild(const XmlNode* child) const
 }
 
 
+/*******************************************************************************
+
+********************************************************************************/
+store::Iterator_t InternalNode::getDescendantElements(
+    const store::Item* name) const
+{
+  const QNameItem* qname = static_cast<const QNameItem*>(name)->getNormalized();
+  ElementNameList_t list;
+
+  if (!getTree()->findElements(qname, list))
+    return NULL;
+
+  return new DescendantElementsIterator(const_cast<InternalNode*>(this), list);
+}
+
+
 /*******************************************************************************
   Insert a new child node as the i-th child of "this". If i > theChildren2.size()
   the new child is inserted as the last child.
@@ -1703,6 +1833,8 @@ void InternalNode::insertChild(XmlNode* child, csize pos)
   assert(child->theParent == NULL || child->theParent == this);
 
   child->theParent = this;
+
+  getTree()->invalidateElementNames();
 }
 
 
@@ -1718,6 +1850,8 @@ void InternalNode::removeChild(csize pos)
     assert(!(*ite)->isConnectorNode());
     (*ite)->theParent = NULL;
     theNodes.erase(ite);
+
+    getTree()->invalidateElementNames();
   }
 }
 
@@ -1736,6 +1870,8 @@ void InternalNode::removeConnector(csize pos)
     connector->theParent = NULL;
     theNodes.erase(ite);
     delete connector;
+
+    getTree()->invalidateElementNames();
   }
 }
 
@@ -1771,6 +1907,8 @@ csize InternalNode::removeChild(XmlNode* child)
 
     theNodes.erase(ite);
 
+    getTree()->invalidateElementNames();
+
     return pos;
   }
   else
@@ -5703,7 +5841,7 @@ FTTokenIterator_t XmlNode::getTokens(
 
   FTTokenStore::range_type const &r = token_store.getRange( this );
   return FTTokenIterator_t(
-    new NaiveFTTokenIterator( tokens, r.first, r.second )
+    new NaiveFTTokenIterator( token_store, r.first, r.second )
   );
 }
 
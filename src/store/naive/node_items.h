@@ -31,8 +31,10 @@
 #endif /* ZORBA_NO_FULL_TEXT */
 #include "diagnostics/assert.h"
 #include "zorbatypes/zstring.h"
+#include "util/unordered_map.h"
 #include "zorbautils/fatal.h"
 #include "zorbautils/hashfun.h"
+#include "zorbautils/mutex.h"
 
 #ifndef ZORBA_NO_FULL_TEXT
 #include "ft_token_store.h"
@@ -115,6 +117,21 @@ class XmlNodeTokenizerCallback;
 #endif /* ZORBA_NO_FULL_TEXT */
 
 
+/*******************************************************************************
+  The elements of an XmlTree that have a given name, in document order (see
+  XmlTree::theElementNames). A list is shared by the element-name index of the
+  tree and by the iterators that are scanning it, so that dropping the index
+  does not pull the list from under them.
+********************************************************************************/
+class ElementNameList : public SyncedRCObject
+{
+public:
+  std::vector<XmlNode*> theNodes;
+};
+
+typedef rchandle<ElementNameList> ElementNameList_t;
+
+
 #define NODE_STOP \
   ZORBA_FATAL(0, "Invalid method invocation on " \
               << store::StoreConsts::toString(getNodeKind()))
@@ -173,6 +190,21 @@ class XmlNodeTokenizerCallback;
 
   theTokens:
   ----------
+
+  theElementNames:
+  ----------------
+  For each distinct element name, the elements of the tree having that name, in
+  document order. It is built by the second name lookup on the tree, and it is
+  dropped on every structural or rename update of the tree.
+
+  theNumNameLookups:
+  ------------------
+  The number of name lookups since the tree was created or last updated.
+
+  theElementNamesFailed:
+  ----------------------
+  True if theElementNames could not be built because the tree contains
+  connector nodes. The build is not retried until the tree is updated.
 ********************************************************************************/
 class XmlTree
 {
@@ -188,6 +220,9 @@ class XmlTree
   typedef NodePointerHashMap<store::Item_t> NodeTypeMap;
 #endif
 
+  typedef std::unordered_map<const store::Item*, ElementNameList_t>
+  ElementNameIndex;
+
 protected:
   mutable long              theRefCount;
   SYNC_CODE(mutable RCLock  theRCLock;)
@@ -214,9 +249,16 @@ protected:
   FTTokenStore              theTokens;
 #endif
 
+  ElementNameIndex        * theElementNames;
+  csize                     theNumNameLookups;
+  bool                      theElementNamesFailed;
+  SYNC_CODE(Mutex           theElementNamesMutex;)
+
 protected:
   XmlTree(XmlNode* root, const TreeId& id);
 
+  bool buildElementNames();
+
 public:
   XmlTree();
 
@@ -300,6 +342,10 @@ public:
 #ifndef ZORBA_NO_FULL_TEXT
   FTTokenStore& getTokenStore() { return theTokens; }
 #endif
+
+  bool findElements(const store::Item* name, ElementNameList_t& result);
+
+  void invalidateElementNames();
 };
 
 
@@ -874,6 +920,8 @@ public:
     return reinterpret_cast<AttributeNode*>(*ite);
   }
 
+  store::Iterator_t getDescendantElements(const store::Item* name) const;
+
   void deleteChild(UpdDelete& upd);
 
   void restoreChild(UpdDelete& upd);
@@ -139,6 +139,85 @@ bool AttributesIteratorImpl::next(store::Item_t& result)
 }
 
 
+/////////////////////////////////////////////////////////////////////////////////
+//                                                                             //
+//  class DescendantElementsIterator                                           //
+//                                                                             //
+/////////////////////////////////////////////////////////////////////////////////
+
+
+void DescendantElementsIterator::open()
+{
+  theCurrent = 0;
+
+  if (theList == NULL)
+    return;
+
+  const std::vector<XmlNode*>& nodes = theList->theNodes;
+  const OrdPath& rootPath =
+  static_cast<InternalNode*>(theRoot.getp())->getOrdPath();
+
+  csize high = nodes.size();
+
+  while (theCurrent < high)
+  {
+    csize mid = (theCurrent + high) / 2;
+
+    if (static_cast<OrdPathNode*>(nodes[mid])->getOrdPath() < rootPath)
+      theCurrent = mid + 1;
+    else
+      high = mid;
+  }
+}
+
+
+bool DescendantElementsIterator::next(store::Item_t& result)
+{
+  if (theList == NULL)
+    return false;
+
+  const std::vector<XmlNode*>& nodes = theList->theNodes;
+  InternalNode* root = static_cast<InternalNode*>(theRoot.getp());
+
+  while (theCurrent < nodes.size())
+  {
+    OrdPathNode* node = static_cast<OrdPathNode*>(nodes[theCurrent]);
+
+    if (node == root)
+    {
+      ++theCurrent;
+      continue;
+    }
+
+    if (root->getOrdPath().getRelativePosition(node->getOrdPath()) !=
+        OrdPath::DESCENDANT)
+    {
+      theCurrent = nodes.size();
+      return false;
+    }
+
+    ++theCurrent;
+    result = node;
+    return true;
+  }
+
+  return false;
+}
+
+
+void DescendantElementsIterator::reset()
+{
+  open();
+}
+
+
+void DescendantElementsIterator::close()
+{
+  theRoot = NULL;
+  theList = NULL;
+}
+
+
 /////////////////////////////////////////////////////////////////////////////////
 //                                                                             //
 //  class NodeDistinctIterator                                                 //
@@ -358,6 +358,43 @@ public:
 };
 
 
+/*******************************************************************************
+  This iterator returns, in document order, the descendant elements of a node
+  that have a given name. It scans the list of the elements of the node's tree
+  that have that name (see XmlTree::findElements): the descendants of the node
+  form a contiguous range of the list, starting right after the node itself,
+  which open() locates by binary search. Only the requested prefix of the
+  range is visited.
+
+  theRoot    : The node whose descendants are returned. Holding it keeps its
+               tree, and thus the nodes in theList, alive.
+  theList    : The document-ordered elements of the tree that have the name, or
+               NULL if there are none.
+  theCurrent : The position in theList of the next candidate.
+********************************************************************************/
+class DescendantElementsIterator : public store::Iterator
+{
+protected:
+  store::Item_t      theRoot;
+  ElementNameList_t  theList;
+  csize              theCurrent;
+
+public:
+  DescendantElementsIterator(InternalNode* root, const ElementNameList_t& list)
+    :
+    theRoot(root),
+    theList(list),
+    theCurrent(0)
+  {
+  }
+
+  void open();
+  bool next(store::Item_t& result);
+  void reset();
+  void close();
+};
+
+
 /*******************************************************************************
   This iterator is used to eliminated duplicate nodes in the multiset of nodes
   produced by another iterator.
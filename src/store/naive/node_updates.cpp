@@ -1222,6 +1222,8 @@ void ElementNode::replaceContent(UpdReplaceElemContent& upd)
 
   theNodes.resize(theNumAttrs);
 
+  getTree()->invalidateElementNames();
+
   if (upd.theNewChild == NULL || upd.theNewChild->getStringValue().empty())
     return;
 
@@ -1278,6 +1280,8 @@ void ElementNode::restoreContent(UpdReplaceElemContent& upd)
                            upd.theOldChildren.begin(),
                            upd.theOldChildren.end()); 
 
+  getTree()->invalidateElementNames();
+
   restoreType(upd.theTypeUndoList);
 }
 
@@ -1295,6 +1299,8 @@ void ElementNode::replaceName(UpdRenameElem& upd)
   upd.theOldName.transfer(theName);
   theName.transfer(upd.theNewName);
 
+  getTree()->invalidateElementNames();
+
   if (upd.theNewBinding && 
       (!upd.thePul->inheritNSBindings() ||  theName->getPrefix().empty()))
   {
@@ -1359,6 +1365,8 @@ void ElementNode::restoreName(UpdRenameElem& upd)
 
   theName.transfer(upd.theOldName);
 
+  getTree()->invalidateElementNames();
+
   if (upd.theRestoreParentType)
     theParent->restoreType(upd.theTypeUndoList);
   else
@@ -696,6 +696,269 @@ void SimpleCollection::CollectionIter::close()
   //SYNC_CODE(theCollection->theLatch.unlock();)
 }
 
+
+/*******************************************************************************
+
+********************************************************************************/
+store::Iterator_t SimpleCollection::getFilteredIterator(
+    const store::CollectionFilter& filter)
+{
+  return new FilteredCollectionIter(this, filter);
+}
+
+
+/*******************************************************************************
+  Record a filtered scan of this collection.
+********************************************************************************/
+void SimpleCollection::addFilterStats(
+    const store::CollectionFilter& filter,
+    uint64_t scanned,
+    uint64_t selected)
+{
+  SYNC_CODE(AutoMutex lock(&theFilterStatsMutex);)
+
+  std::vector<store::CollectionFilterStats>::iterator ite = theFilterStats.begin();
+  std::vector<store::CollectionFilterStats>::iterator end = theFilterStats.end();
+
+  for (; ite != end; ++ite)
+  {
+    const store::CollectionFilter& f = ite->theFilter;
+
+    if (f.theHasValue != filter.theHasValue ||
+        f.thePath.size() != filter.thePath.size())
+      continue;
+
+    csize i = 0;
+    while (i < f.thePath.size() &&
+           f.thePath[i]->getTypeCode() == filter.thePath[i]->getTypeCode() &&
+           f.thePath[i]->equals(filter.thePath[i]))
+      ++i;
+
+    if (i == f.thePath.size())
+      break;
+  }
+
+  if (ite == end)
+  {
+    if (theFilterStats.size() >= MAX_FILTER_STATS)
+      return;
+
+    theFilterStats.push_back(store::CollectionFilterStats());
+    theFilterStats.back().theFilter.thePath = filter.thePath;
+    theFilterStats.back().theFilter.theHasValue = filter.theHasValue;
+    ite = theFilterStats.end() - 1;
+  }
+
+  ++ite->theScans;
+  ite->theScanned += scanned;
+  ite->theSelected += selected;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void SimpleCollection::getFilterStats(
+    std::vector<store::CollectionFilterStats>& stats) const
+{
+  SYNC_CODE(AutoMutex lock(&theFilterStatsMutex);)
+
+  stats = theFilterStats;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+SimpleCollection::FilteredCollectionIter::FilteredCollectionIter(
+    SimpleCollection* collection,
+    const store::CollectionFilter& filter)
+  :
+  CollectionIter(collection, numeric_consts<xs_integer>::zero()),
+  theFilter(filter),
+  theScanned(0),
+  theSelected(0)
+{
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void SimpleCollection::FilteredCollectionIter::open()
+{
+  CollectionIter::open();
+  theScanned = 0;
+  theSelected = 0;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void SimpleCollection::FilteredCollectionIter::reset()
+{
+  reportStats();
+  CollectionIter::reset();
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void SimpleCollection::FilteredCollectionIter::close()
+{
+  reportStats();
+  CollectionIter::close();
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool SimpleCollection::FilteredCollectionIter::next(store::Item_t& result)
+{
+  if (theVersion != theCollection->theVersion)
+  {
+    throw ZORBA_EXCEPTION(zerr::ZDDY0041_CONCURRENT_MODIFICATION,
+    ERROR_PARAMS(theCollection->getName()->getStringValue()));
+  }
+
+  if (!theHaveLock) 
+  {
+    throw ZORBA_EXCEPTION(zerr::ZDDY0019_COLLECTION_ITERATOR_NOT_OPEN,
+    ERROR_PARAMS(theCollection->getName()->getStringValue()));
+  }
+
+  while (theIterator != theEnd)
+  {
+    const store::Item* tree = theIterator->getp();
+    ++theIterator;
+    ++theScanned;
+
+    if (mayMatch(tree, 0))
+    {
+      ++theSelected;
+      result = const_cast<store::Item*>(tree);
+      return true;
+    }
+  }
+
+  reportStats();
+
+  result = NULL;
+  return false;
+}
+
+
+/*******************************************************************************
+  Add the counts of the current scan to the statistics of the collection, so
+  that they are visible as soon as the scan is exhausted. A scan that has not
+  tested any tree is not reported.
+********************************************************************************/
+void SimpleCollection::FilteredCollectionIter::reportStats()
+{
+  if (theScanned == 0)
+    return;
+
+  theCollection->addFilterStats(theFilter, theScanned, theSelected);
+  theScanned = 0;
+  theSelected = 0;
+}
+
+
+/*******************************************************************************
+  Return false only if it is certain that the filter predicate is false for the
+  given item when the filter path is applied starting at the given step. When
+  in doubt (typed nodes, non-string atomics, etc.) return true, so that the
+  query runtime makes the decision.
+********************************************************************************/
+bool SimpleCollection::FilteredCollectionIter::mayMatch(
+    const store::Item* item,
+    csize step)
+{
+  if (step == theFilter.thePath.size())
+  {
+    if (!theFilter.theHasValue)
+      return true;
+
+    if (item->isNode())
+    {
+      const XmlNode* node = static_cast<const XmlNode*>(item);
+
+      // The typed value of an element annotated with xs:untyped or, as
+      // constructed elements are in preserve mode, xs:anyType is its string
+      // value as xs:untypedAtomic.
+      if (node->getNodeKind() == store::StoreConsts::elementNode)
+      {
+        const store::Item* type = node->getType();
+
+        if (!type->equals(GET_STORE().XS_UNTYPED_QNAME) &&
+            !type->equals(GET_STORE().XS_ANY_QNAME))
+          return true;
+      }
+
+      theBuffer.clear();
+      node->getStringValue2(theBuffer);
+      return theBuffer == theFilter.theValue;
+    }
+
+    if (!item->isAtomic())
+      return true;
+
+    switch (item->getTypeCode())
+    {
+    case store::XS_STRING:
+    case store::XS_UNTYPED_ATOMIC:
+    case store::XS_ANY_URI:
+      return item->getString() == theFilter.theValue;
+    default:
+      return true;
+    }
+  }
+
+  const store::Item* stepItem = theFilter.thePath[step].getp();
+
+  if (stepItem->getTypeCode() == store::XS_QNAME)
+  {
+    if (!item->isNode())
+      return true;
+
+    const XmlNode* node = static_cast<const XmlNode*>(item);
+    store::StoreConsts::NodeKind kind = node->getNodeKind();
+
+    if (kind != store::StoreConsts::documentNode &&
+        kind != store::StoreConsts::elementNode)
+      return false;
+
+    const InternalNode* parent = static_cast<const InternalNode*>(node);
+    csize numChildren = parent->numChildren();
+
+    for (csize i = 0; i < numChildren; ++i)
+    {
+      const XmlNode* child = parent->getChild(i);
+
+      if (child->getNodeKind() == store::StoreConsts::elementNode &&
+          child->getNodeName()->equals(stepItem) &&
+          mayMatch(child, step + 1))
+        return true;
+    }
+
+    return false;
+  }
+
+  if (!item->isObject())
+    return false;
+
+  const store::Item* value = static_cast<const json::SimpleJSONObject*>(item)->
+      findObjectValue(stepItem->getString().c_str());
+
+  if (value == NULL)
+    return false;
+
+  return mayMatch(value, step + 1);
+}
+
 } // namespace simplestore
 } // namespace zorba
 /* vim:set et sw=2 ts=2: */
@@ -26,6 +26,7 @@
 #include "tree_id_generator.h"
 
 #include "zorbautils/latch.h"
+#include "zorbautils/mutex.h"
 #include "zorbautils/checked_vector.h"
 
 
@@ -66,6 +67,12 @@ namespace zorba { namespace simplestore {
   properties are specified by the user in the collection declaration. Dynamic
   collections use pre-determined default values.
 
+  theFilterStats:
+  ---------------
+  Statistics about the filtered scans of this collection (see
+  FilteredCollectionIter), one entry per filter path and kind. At most
+  MAX_FILTER_STATS entries are kept; further filters are not recorded.
+
   theLatch:
   ---------
   Synchronizes concurrent accesses to the collection.
@@ -73,9 +80,12 @@ namespace zorba { namespace simplestore {
 class SimpleCollection : public Collection
 {
   friend class CollectionIter;
+  friend class FilteredCollectionIter;
   friend class UpdTruncateCollection;
 
 public:
+  static const csize MAX_FILTER_STATS = 64;
+
   class CollectionIter : public store::Iterator
 	{
   protected:
@@ -101,6 +111,36 @@ public:
   };
 
 
+  /*****************************************************************************
+    An iterator over the trees of the collection that skips the trees which
+    definitely do not satisfy a store::CollectionFilter. Trees are tested in
+    place, so rejected trees are never handed out (or ref-counted).
+  ******************************************************************************/
+  class FilteredCollectionIter : public CollectionIter
+  {
+  protected:
+    const store::CollectionFilter & theFilter;
+    zstring                         theBuffer;
+    uint64_t                        theScanned;
+    uint64_t                        theSelected;
+
+  public:
+    FilteredCollectionIter(
+        SimpleCollection* collection,
+        const store::CollectionFilter& filter);
+
+    void open();
+    bool next(store::Item_t& result);
+    void reset();
+    void close();
+
+  private:
+    void reportStats();
+
+    bool mayMatch(const store::Item* item, csize step);
+  };
+
+
 protected:
   ulong                                  theId;
 
@@ -114,8 +154,12 @@ protected:
 
   ulong                                  theVersion;
 
+  std::vector<store::CollectionFilterStats> theFilterStats;
+
   SYNC_CODE(Latch                        theLatch;)
 
+  SYNC_CODE(mutable Mutex                theFilterStatsMutex;)
+
 protected:
   // default constructor added in order to allow subclasses to instantiate
   // a collection without name
@@ -143,6 +187,10 @@ public:
 
   store::Iterator_t getIterator(const xs_integer& skip, const zstring& start);
 
+  store::Iterator_t getFilteredIterator(const store::CollectionFilter& filter);
+
+  void getFilterStats(std::vector<store::CollectionFilterStats>& stats) const;
+
   bool findNode(const store::Item* node, xs_integer& position) const;
 
   store::Item_t nodeAt(xs_integer position);
@@ -170,6 +218,11 @@ public:
   void removeAll();
 
   void adjustTreePositions();
+
+  void addFilterStats(
+      const store::CollectionFilter& filter,
+      uint64_t scanned,
+      uint64_t selected);
 };
 
 } // namespace store
@@ -1694,6 +1694,8 @@ void ProbeGeneralIndexIterator::init(const store::IndexCondition_t& cond,
   if (theProbeKind == store::IndexCondition::POINT_VALUE ||
       theProbeKind == store::IndexCondition::POINT_GENERAL)
   {
+    // Drop the result sets of any previous probe done with this iterator.
+    theResultSets.clear();
     initPoint();
   }
   else
@@ -485,7 +485,9 @@ void ProbeValueHashIndexIterator::init(const store::IndexCondition_t& cond,
 
   assert(key->size() == theIndex->getNumColumns());
 
-  theIndex->theMap.get(key, theResultSet);
+  // Do not keep the result set of a previous probe if the key is not found.
+  if (!theIndex->theMap.get(key, theResultSet))
+    theResultSet = NULL;
 
   if (theResultSet)
   {
@@ -24,7 +24,7 @@
 #include "simple_index.h"
 
 #include "zorbautils/hashfun.h"
-#include "zorbautils/hashmap.h"
+#include "zorbautils/open_hashmap.h"
 
 
 namespace zorba 
@@ -84,7 +84,7 @@ public:
     }
   };
 
-  typedef HashMap<store::Item*, NodeUpdates*, CompareFunction> Map;
+  typedef OpenHashMap<store::Item*, NodeUpdates*, CompareFunction> Map;
 
   typedef Map::iterator iterator;
 
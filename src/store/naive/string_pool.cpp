@@ -48,6 +48,36 @@ StringPool::~StringPool()
 }
 
 
+/*******************************************************************************
+  Same as HashSet::insert(), except that a string placed in the pool always has
+  a representation of its own. The pool finds the strings that are not used
+  outside the pool by checking whether their representation is shared, but the
+  static representations of single-character strings are always shared.
+********************************************************************************/
+bool StringPool::insert(zstring& str)
+{
+  // The fill constructor always allocates a representation.
+  if (str.length() == 1)
+    str = zstring(1, str[0]);
+
+  return HashSet<zstring, StringPoolCompareFunction>::insert(str);
+}
+
+
+/*******************************************************************************
+  Same as HashSet::insert(), except that a string placed in the pool always has
+  a representation of its own (see above).
+********************************************************************************/
+bool StringPool::insert(const zstring& str, zstring& outStr)
+{
+  if (str.length() != 1)
+    return HashSet<zstring, StringPoolCompareFunction>::insert(str, outStr);
+
+  zstring copy(1, str[0]);
+  return HashSet<zstring, StringPoolCompareFunction>::insert(copy, outStr);
+}
+
+
 /*******************************************************************************
   Check if the given string is already in the pool and if not, make a copy of it
   and place the copy in the pool. Return true if the string was already in the
@@ -55,6 +55,10 @@ public:
 
   ~StringPool();
 
+  bool insert(zstring& str);
+
+  bool insert(const zstring& str, zstring& outStr);
+
   bool insertc(const char* str, zstring& outStr);
 
 protected:
@@ -21,6 +21,7 @@
 # include <unicode/uclean.h>
 # include <unicode/utypes.h>
 # include <unicode/udata.h>
+# include "util/regex.h"
 #endif /* ZORBA_NO_ICU */
 
 #ifdef ZORBA_WITH_BIG_INTEGER
@@ -282,6 +283,8 @@ void GlobalEnvironment::cleanup_icu()
   // valgrind from reporting those problems at the end
   // see http://www.icu-project.org/apiref/icu4c/uclean_8h.html#93f27d0ddc7c196a1da864763f2d8920
 #ifndef ZORBA_NO_ICU
+  // cached regex patterns must be freed while ICU is still alive
+  unicode::regex::clear_cache();
   u_cleanup();
 # if defined U_STATIC_IMPLEMENTATION && (defined WIN32 || defined WINCE)
   delete[] icu_appdata;
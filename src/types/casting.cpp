@@ -2927,6 +2927,81 @@ bool GenericCast::castToBuiltinAtomic(
 }
 
 
+/*******************************************************************************
+  Resolve the functions that castToBuiltinAtomic() would use to cast an item
+  whose type is exactly the builtin atomic type S to the builtin atomic type T.
+  The resolved cast is left unresolved if S and T are the same type or if the
+  cast is not allowed; castToBuiltinAtomic() then takes its generic path.
+********************************************************************************/
+void GenericCast::resolveCast(
+    store::SchemaTypeCode sourceTypeCode,
+    store::SchemaTypeCode targetTypeCode,
+    ResolvedCast& cast)
+{
+  cast.theSourceTypeCode = sourceTypeCode;
+  cast.theTargetTypeCode = targetTypeCode;
+  cast.theCastFunc = 0;
+  cast.theDownCastFunc = 0;
+
+  if (sourceTypeCode >= store::XS_LAST ||
+      targetTypeCode >= store::XS_LAST ||
+      sourceTypeCode == targetTypeCode ||
+      sourceTypeCode == store::XS_ANY_ATOMIC ||
+      targetTypeCode == store::XS_ANY_ATOMIC ||
+      targetTypeCode == store::XS_NOTATION)
+    return;
+
+  cast.theCastFunc = theCastMatrix[theMapping[sourceTypeCode]]
+                                  [theMapping[targetTypeCode]];
+
+  if (targetTypeCode != store::XS_STRING &&
+      targetTypeCode != store::XS_INTEGER)
+    cast.theDownCastFunc = theDownCastMatrix[theMapping[targetTypeCode]];
+}
+
+
+/*******************************************************************************
+  Same as the castToBuiltinAtomic() above, using a cast resolved by
+  resolveCast(). Items whose type is not the source type of the resolved cast
+  are cast through the generic path.
+********************************************************************************/
+bool GenericCast::castToBuiltinAtomic(
+    store::Item_t& result,
+    store::Item_t& item,
+    const ResolvedCast& cast,
+    const namespace_context* nsCtx,
+    const QueryLoc& loc)
+{
+  if (!cast.isResolved() || item->getTypeCode() != cast.theSourceTypeCode)
+    return castToBuiltinAtomic(result, item, cast.theTargetTypeCode, nsCtx, loc);
+
+  store::ItemFactory* factory = GENV_ITEMFACTORY;
+  zstring stringValue;
+
+  ErrorInfo errInfo(cast.theSourceTypeCode, cast.theTargetTypeCode, loc);
+
+  if (theMapping[cast.theSourceTypeCode] == theMapping[store::XS_STRING])
+  {
+    item->getStringValue2(stringValue);
+  }
+
+  if (!(*cast.theCastFunc)(result, item, stringValue, factory, nsCtx, errInfo, true))
+    return false;
+
+  if (cast.theDownCastFunc != 0)
+  {
+    return (*cast.theDownCastFunc)(result,
+                                   &*result,
+                                   cast.theTargetTypeCode,
+                                   factory,
+                                   errInfo,
+                                   true);
+  }
+
+  return true;
+}
+
+
 /*******************************************************************************
   Casts an atomic item to a qname, if possible.
 ********************************************************************************/
@@ -57,6 +57,36 @@ private:
 
   GenericCast() {}
     
+public:
+  /**
+   * The cast and down-cast functions that castToBuiltinAtomic() selects for a
+   * given pair of builtin atomic source and target types. It is resolved once
+   * by resolveCast(), so that iterators which know the type of their input at
+   * compile time do not have to redo the dispatch for every item they cast.
+   */
+  class ResolvedCast
+  {
+    friend class GenericCast;
+
+  private:
+    store::SchemaTypeCode theSourceTypeCode;
+    store::SchemaTypeCode theTargetTypeCode;
+    CastFunc              theCastFunc;
+    DownCastFunc          theDownCastFunc;
+
+  public:
+    ResolvedCast()
+      :
+      theSourceTypeCode(store::XS_LAST),
+      theTargetTypeCode(store::XS_LAST),
+      theCastFunc(0),
+      theDownCastFunc(0)
+    {
+    }
+
+    bool isResolved() const { return theCastFunc != 0; }
+  };
+
 public:
   ~GenericCast() {}
 			
@@ -131,6 +161,18 @@ public:
         const QueryLoc& loc,
         bool throw_on_error = true);
 
+  static void resolveCast(
+        store::SchemaTypeCode sourceType,
+        store::SchemaTypeCode targetType,
+        ResolvedCast& cast);
+
+  static bool castToBuiltinAtomic(
+        store::Item_t& result,
+        store::Item_t& item,
+        const ResolvedCast& cast,
+        const namespace_context* nsCtx,
+        const QueryLoc& loc);
+
   static bool castToQName(
         store::Item_t& result,
         const store::Item_t& item,
@@ -250,6 +250,9 @@ static test const decode_tests[] = {
   /* 7 */ { "Tm93IGlzIHRoZSB0aW", "Now is the ti" },
   /* 8 */ { "Tm93IGlzIHRoZSB0a", "Now is the t" },
 
+  // newlines inside and between 4-character chunks
+  /* 9 */ { "Tm9\n3IGlz\r\nIHRoZSB0aW1l", "Now is the time" },
+
   { 0, 0 }
 };
 
@@ -266,6 +269,7 @@ static char const *const decode_exception_tests[] = {
   "ZmX=",
   "ZX==",
   "ZX===",
+  "Tm93IGlzIHRoZSB0aW_l",
   0
 };
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stdafx.h"
+
+#include <iostream>
+#include <sstream>
+
+#include "runtime/parsing_and_serializing/fragment_istream.h"
+
+using namespace std;
+using namespace zorba;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int failures;
+
+static bool assert_true( char const *expr, int line, bool result ) {
+  if ( !result ) {
+    cout << "FAILED, line " << line << ": " << expr << endl;
+    ++failures;
+  }
+  return result;
+}
+
+#define ASSERT_TRUE( EXPR ) assert_true( #EXPR, __LINE__, !!(EXPR) )
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Checks that a string set on a FragmentIStream is read in place, not copied,
+ * and that reading the stream gives the whole string.
+ */
+static void test_set_string( int n ) {
+  ostringstream oss;
+  for ( int i = 0; i < n; ++i )
+    oss << "<a>" << i << "</a>";
+  string const expected( oss.str() );
+
+  zstring s( expected );
+  char const *const data = s.data();
+
+  FragmentIStream frag;
+  frag.setString( s );
+
+  ASSERT_TRUE( s.empty() );
+  ASSERT_TRUE( frag.theStream == &frag );
+  ASSERT_TRUE( frag.theIss == NULL );
+  ASSERT_TRUE( frag.theString.data() == data );
+
+  string got;
+  char buf[ FragmentIStream::DEFAULT_BUFFER_SIZE ];
+  while ( frag.theStream->read( buf, sizeof buf ), frag.theStream->gcount() )
+    got.append( buf, static_cast<csize>( frag.theStream->gcount() ) );
+  ASSERT_TRUE( got == expected );
+
+  frag.reset();
+  ASSERT_TRUE( frag.theStream == NULL );
+  ASSERT_TRUE( frag.rdbuf() == NULL );
+  ASSERT_TRUE( frag.theString.empty() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace zorba {
+namespace UnitTests {
+
+int test_fragment_istream( int, char*[] ) {
+  test_set_string( 1 );
+  test_set_string( 10000 );
+
+  cout << failures << " test(s) failed\n";
+  return failures ? 1 : 0;
+}
+
+} // namespace UnitTests
+} // namespace zorba
+/* vim:set et sw=2 ts=2: */
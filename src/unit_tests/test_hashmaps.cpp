@@ -5,10 +5,16 @@
 #include <iostream>
 
 #include "zorbautils/hashmap.h"
+#include "zorbautils/open_hashmap.h"
 #include "util/hashmap32.h"
 #include "util/hashmap.h"
 #include "util/unordered_map.h"
 #include "util/hash/hash.h"
+#include "util/utf8_util.h"
+
+#include "store/api/item.h"
+#include "store/api/item_factory.h"
+#include "system/globalenv.h"
 
 namespace zorba {
 
@@ -59,10 +65,183 @@ public:
 };
 
 
+template <class K, class V, class C>
+static csize map_bytes(const HashMap<K, V, C>& map)
+{
+  return map.capacity() * sizeof(HashEntry<K, V>);
+}
+
+
+template <class K, class V, class C>
+static csize map_bytes(const OpenHashMap<K, V, C>& map)
+{
+  return map.memory_size();
+}
+
+
+/*******************************************************************************
+  Time the insertion of the given keys in the given map, the probing of every
+  key (hits) and of every key in the given miss buffer, and the erasure of all
+  the keys. Also report the memory used per entry after the insertions. Returns
+  false if a key is not found, a miss is found, or the map is not empty after
+  the erasures.
+********************************************************************************/
+template <class Map, class K>
+static bool time_map(
+    const char* name,
+    Map& map,
+    const K* keys,
+    const K* misses,
+    int num)
+{
+  zorba::time::walltime t0, t1, t2, t3;
+  int hits = 0;
+
+  zorba::time::get_current_walltime(t0);
+
+  for (int i = 0; i < num; ++i)
+  {
+    int value = 1;
+    (void)map.insert(keys[i], value);
+  }
+
+  zorba::time::get_current_walltime(t1);
+
+  for (int i = 0; i < num; ++i)
+  {
+    int value;
+    hits += map.get(keys[i], value);
+    hits += map.get(misses[i], value);
+  }
+
+  zorba::time::get_current_walltime(t2);
+
+  csize numEntries = map.size();
+  csize bytes = map_bytes(map);
+
+  for (int i = 0; i < num; ++i)
+  {
+    (void)map.erase(keys[i]);
+  }
+
+  zorba::time::get_current_walltime(t3);
+
+  std::cout << name << ": entries = " << numEntries
+            << " bytes/entry = " << (numEntries ? bytes / numEntries : 0)
+            << " insert = " << time::get_walltime_elapsed(t0, t1)
+            << " probe = " << time::get_walltime_elapsed(t1, t2)
+            << " erase = " << time::get_walltime_elapsed(t2, t3)
+            << " (hits = " << hits << ")" << std::endl;
+
+  if (hits != num || map.size() != 0)
+  {
+    std::cout << name << ": expected " << num << " hits and no entries left"
+              << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+
+/*******************************************************************************
+  The djb2 loop that utf8::hash() used before it handled 4 characters per step.
+********************************************************************************/
+static uint32_t djb2_hash(const std::string& s)
+{
+  const char* str = s.c_str();
+  uint32_t hash = 5381;
+  int c;
+  while ((c = *str++))
+    hash = ((hash << 5) + hash) + c;
+  return hash;
+}
+
+
+/*******************************************************************************
+  Time the hashing of the given strings with the old djb2 loop and with
+  utf8::hash(), and the first and second calls to hash() on string items with
+  the same values; the second calls return the cached hash codes. Returns false
+  if any two of these disagree.
+********************************************************************************/
+static bool time_string_hash(const std::string* keys, int num)
+{
+  std::vector<uint32_t> expected(num);
+  std::vector<store::Item_t> items(num);
+  bool ok = true;
+
+  for (int i = 0; i < num; ++i)
+  {
+    zstring value(keys[i]);
+    GENV_ITEMFACTORY->createString(items[i], value);
+  }
+
+  zorba::time::walltime t0, t1, t2, t3, t4;
+
+  zorba::time::get_current_walltime(t0);
+
+  for (int i = 0; i < num; ++i)
+    expected[i] = djb2_hash(keys[i]);
+
+  zorba::time::get_current_walltime(t1);
+
+  for (int i = 0; i < num; ++i)
+    ok &= (utf8::hash(keys[i]) == expected[i]);
+
+  zorba::time::get_current_walltime(t2);
+
+  for (int i = 0; i < num; ++i)
+    ok &= (items[i]->hash() == expected[i]);
+
+  zorba::time::get_current_walltime(t3);
+
+  for (int i = 0; i < num; ++i)
+    ok &= (items[i]->hash() == expected[i]);
+
+  zorba::time::get_current_walltime(t4);
+
+  std::cout << "djb2 = " << time::get_walltime_elapsed(t0, t1)
+            << " utf8::hash = " << time::get_walltime_elapsed(t1, t2)
+            << " item hash = " << time::get_walltime_elapsed(t2, t3)
+            << " cached item hash = " << time::get_walltime_elapsed(t3, t4)
+            << std::endl;
+
+  if (!ok)
+    std::cout << "hash codes differ" << std::endl;
+
+  return ok;
+}
+
+
+/*******************************************************************************
+  Arguments: test id, load factor, number of keys. Without them, run the
+  HashMap/OpenHashMap comparisons (tests 7 and 8) and the string hash timing
+  (test 9) on 100000 keys, with the default load factor of HashMap.
+********************************************************************************/
 int test_hashmaps(int argc, char* argv[])
 {
   if (argc < 4)
-    return 1;
+  {
+    char arg0[] = "hashmaps";
+    char arg2[] = "0.7";
+    char arg3[] = "100000";
+    char test7[] = "7";
+    char test8[] = "8";
+    char test9[] = "9";
+    char* argv7[] = { arg0, test7, arg2, arg3 };
+    char* argv8[] = { arg0, test8, arg2, arg3 };
+    char* argv9[] = { arg0, test9, arg2, arg3 };
+
+    int result = test_hashmaps(4, argv7);
+    if (result != 0)
+      return result;
+
+    result = test_hashmaps(4, argv8);
+    if (result != 0)
+      return result;
+
+    return test_hashmaps(4, argv9);
+  }
 
   int test_id = atoi(argv[1]);
 
@@ -70,6 +249,8 @@ int test_hashmaps(int argc, char* argv[])
 
   int num = atoi(argv[3]);
 
+  int result = 0;
+
   uint64_t* int_buf = new uint64_t[num];
 
   for (int i = 0; i < num; ++i)
@@ -236,6 +417,42 @@ int test_hashmaps(int argc, char* argv[])
               << "hashmap entries = " << map6.size() << std::endl
               << "Time = " << time << std::endl;
   }
+  else if (test_id == 7 || test_id == 8)
+  {
+    // Compare HashMap and OpenHashMap on the same workload; the misses are
+    // keys outside the range of the inserted ones.
+    uint64_t* int_miss = new uint64_t[num];
+    std::string* str_miss = new std::string[num];
+
+    for (int i = 0; i < num; ++i)
+    {
+      int_miss[i] = int_buf[i] + num;
+      str_miss[i] = str_buf[i] + "x";
+    }
+
+    if (test_id == 7)
+    {
+      OpenHashMap<uint64_t, int, IntCompFunc> omap(1024, false);
+      if (!time_map("HashMap", map1, int_buf, int_miss, num) ||
+          !time_map("OpenHashMap", omap, int_buf, int_miss, num))
+        result = 3;
+    }
+    else
+    {
+      OpenHashMap<std::string, int, StrCompFunc> omap(1024, false);
+      if (!time_map("HashMap", map2, str_buf, str_miss, num) ||
+          !time_map("OpenHashMap", omap, str_buf, str_miss, num))
+        result = 3;
+    }
+
+    delete [] int_miss;
+    delete [] str_miss;
+  }
+  else if (test_id == 9)
+  {
+    if (!time_string_hash(str_buf, num))
+      result = 3;
+  }
   else
   {
     std::cout << "Invalid test id" << std::endl;
@@ -245,7 +462,7 @@ int test_hashmaps(int argc, char* argv[])
   delete [] int_buf;
   delete [] str_buf;
 
-  return 0;
+  return result;
 }
 
 
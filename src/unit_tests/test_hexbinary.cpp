@@ -244,6 +244,7 @@ static char const *const decode_exception_tests[] = {
   /* 7 */ "!!",
   /* 8 */ "##",
   /* 9 */ "$$",
+  /*10 */ "4E6F7720697320G4",
   0
 };
 
@@ -0,0 +1,157 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stdafx.h"
+
+#include <iostream>
+#include <sstream>
+
+#include <zorba/internal/cxx_util.h>
+
+#include "store/api/item_factory.h"
+#include "store/api/store.h"
+#include "store/naive/atomic_items.h"
+#include "system/globalenv.h"
+#include "util/utf8_util.h"
+
+using namespace std;
+using namespace zorba;
+
+///////////////////////////////////////////////////////////////////////////////
+
+static int failures;
+
+static bool assert_true( char const *expr, int line, bool result ) {
+  if ( !result ) {
+    cout << "FAILED, line " << line << ": " << expr << endl;
+    ++failures;
+  }
+  return result;
+}
+
+#define ASSERT_TRUE( EXPR ) assert_true( #EXPR, __LINE__, !!(EXPR) )
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace zorba {
+namespace simplestore {
+
+/**
+ * Exposes the cached hash code of a StringItem.
+ */
+class TestStringItem : public StringItem {
+public:
+  TestStringItem( zstring &value ) : StringItem( store::XS_STRING, value ) { }
+  uint32_t cached_hash() const { return theHash; }
+};
+
+/**
+ * Exposes the cached hash code of an UntypedAtomicItem.
+ */
+class TestUntypedAtomicItem : public UntypedAtomicItem {
+public:
+  TestUntypedAtomicItem( zstring &value ) :
+    UntypedAtomicItem( store::XS_UNTYPED_ATOMIC, value ) { }
+  uint32_t cached_hash() const { return theHash; }
+};
+
+} // namespace simplestore
+} // namespace zorba
+
+using namespace zorba::simplestore;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Checks that the hash code of the given item is not computed before the first
+ * call to hash(), is equal to utf8::hash() of its value, and is kept.
+ */
+template<class ItemType>
+static void test_cached( char const *s ) {
+  zstring const expected_value( s );
+  uint32_t const expected = utf8::hash( expected_value );
+
+  zstring value( s );
+  store::Item_t const item( new ItemType( value ) );
+  ItemType const *const p = static_cast<ItemType const*>( item.getp() );
+
+  ASSERT_TRUE( p->cached_hash() == 0 );
+  ASSERT_TRUE( item->hash() == expected );
+  ASSERT_TRUE( p->cached_hash() == expected );
+  ASSERT_TRUE( item->hash() == expected );
+  ASSERT_TRUE( p->cached_hash() == expected );
+
+  //
+  // An item made from a copy of the value, which shares its representation,
+  // computes its own hash code rather than getting a stale one.
+  //
+  zstring copy( item->getString() );
+  store::Item_t const copy_item( new ItemType( copy ) );
+  ItemType const *const q = static_cast<ItemType const*>( copy_item.getp() );
+  ASSERT_TRUE( q->cached_hash() == 0 );
+  ASSERT_TRUE( copy_item->hash() == expected );
+
+  //
+  // An item with another value gets another hash code.
+  //
+  zstring other_value( expected_value );
+  other_value += 'x';
+  uint32_t const other_expected = utf8::hash( other_value );
+  store::Item_t const other( new ItemType( other_value ) );
+  ASSERT_TRUE( other->hash() == other_expected );
+  ASSERT_TRUE( item->hash() == expected );
+}
+
+/**
+ * Checks that a streamable string is hashed by its whole value.
+ */
+static void test_streamable() {
+  string const s( 10000, 'a' );
+  istringstream is( s );
+
+  store::Item_t item;
+  GENV_ITEMFACTORY->createStreamableString( item, is, nullptr );
+  ASSERT_TRUE( !!item );
+
+  uint32_t const expected = utf8::hash( zstring( s ) );
+  ASSERT_TRUE( item->hash() == expected );
+  ASSERT_TRUE( item->hash() == expected );
+  ASSERT_TRUE( item->getString() == s.c_str() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace zorba {
+namespace UnitTests {
+
+int test_item_hash( int, char*[] ) {
+  test_cached<TestStringItem>( "" );
+  test_cached<TestStringItem>( "a" );
+  test_cached<TestStringItem>( "hello, world" );
+  test_cached<TestStringItem>( "h\xC3\xA9llo" );
+
+  test_cached<TestUntypedAtomicItem>( "a" );
+  test_cached<TestUntypedAtomicItem>( "hello, world" );
+
+  test_streamable();
+
+  cout << failures << " test(s) failed\n";
+  return failures ? 1 : 0;
+}
+
+} // namespace UnitTests
+} // namespace zorba
+/* vim:set et sw=2 ts=2: */
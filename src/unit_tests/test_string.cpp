@@ -418,6 +418,30 @@ static void test_take() {
   ASSERT_TRUE( s2 == "hello" );
 }
 
+static void test_char_rep() {
+  zstring const s( "abc" );
+  zstring s1( s.substr( 1, 1 ) );
+  zstring s2( s.substr( 1, 1 ) );
+  ASSERT_TRUE( s1.data() == s2.data() );
+
+  s1 += 'x';
+  ASSERT_TRUE( s1 == "bx" );
+  ASSERT_TRUE( s2 == "b" );
+
+  zstring s3( s2 );
+  s3[0] = 'q';
+  ASSERT_TRUE( s3 == "q" );
+  s3.clear();
+  ASSERT_TRUE( s3.empty() );
+  ASSERT_TRUE( s2 == "b" );
+
+  zstring s4( "b" );
+  s4.insert( s4.begin(), 'a' );
+  ASSERT_TRUE( s4 == "ab" );
+  ASSERT_TRUE( zstring( "b" ) == "b" );
+  ASSERT_TRUE( ::strcmp( zstring( "b" ).c_str(), "b" ) == 0 );
+}
+
 template<class StringType>
 static void test_reverse( char const *s ) {
   StringType const s1( s );
@@ -754,6 +778,32 @@ static void test_validate_with_size() {
   ASSERT_TRUE( utf8::validate( invalid, 1 ) == invalid );
 }
 
+static void test_ascii_runs() {
+  // long enough to exercise the word-at-a-time checks
+  string const ascii( 100, 'a' );
+  string const mixed( ascii + utf8_aacute + ascii + utf8_eacute + "b" );
+
+  ASSERT_TRUE( ascii::is_ascii( ascii.data(), ascii.size() ) );
+  ASSERT_TRUE( !ascii::is_ascii( mixed.data(), mixed.size() ) );
+  ASSERT_TRUE(
+    ascii::find_non_ascii( mixed.data(), mixed.data() + mixed.size() )
+    == mixed.data() + 100
+  );
+
+  ASSERT_TRUE( utf8::length( mixed.c_str() ) == 203 );
+  ASSERT_TRUE(
+    utf8::length( mixed.data(), mixed.data() + mixed.size() ) == 203
+  );
+  ASSERT_TRUE( utf8::byte_pos( mixed.data(), mixed.size(), 101 ) == 102 );
+  ASSERT_TRUE( utf8::byte_pos( mixed.data(), mixed.size(), 203 ) == 205 );
+  ASSERT_TRUE( utf8::byte_pos( mixed.data(), mixed.size(), 204 ) == utf8::npos );
+  ASSERT_TRUE( utf8::char_pos( mixed.data(), mixed.data() + 204 ) == 202 );
+  ASSERT_TRUE( utf8::validate( mixed.data(), mixed.size() ) == 0 );
+  ASSERT_TRUE(
+    utf8::validate( mixed.data(), 101 ) == mixed.data() + 100
+  );
+}
+
 template<class StringType>
 static void test_xml_escape() {
   StringType const s( "&b<de>" );
@@ -816,6 +866,8 @@ int test_string( int, char*[] ) {
   test_take<zstring>();
   test_take<zstring_p>();
 
+  test_char_rep();
+
   test_utf8_string<string>();
   test_utf8_string<zstring>();
   test_utf8_string<zstring_p>();
@@ -921,6 +973,8 @@ int test_string( int, char*[] ) {
   test_validate();
   test_validate_with_size();
 
+  test_ascii_runs();
+
   test_xml_escape<string>();
   test_xml_escape<String>();
 
@@ -31,6 +31,7 @@ namespace UnitTests {
   int test_ato_( int, char*[] );
   int test_base64( int, char*[] );
   int test_base64_streambuf( int, char*[] );
+  int test_fragment_istream( int, char*[] );
   int test_fs_util( int, char*[] );
   int test_hashmaps( int argc, char* argv[] );
   int test_hexbinary( int argc, char* argv[] );
@@ -40,6 +41,8 @@ namespace UnitTests {
   int test_icu_streambuf( int, char*[] );
 #endif /* ZORBA_NO_ICU */
 
+  int test_item_hash( int, char*[] );
+
   int test_json_parser( int, char*[] );
   int test_mem_sizeof( int, char*[] );
   int test_parameters( int, char*[] );
@@ -42,6 +42,7 @@ void initializeTestList()
   libunittests["ato"] = test_ato_;
   libunittests["base64"] = test_base64;
   libunittests["base64_streambuf"] = test_base64_streambuf;
+  libunittests["fragment_istream"] = test_fragment_istream;
   libunittests["fs_util"] = test_fs_util;
   libunittests["hashmaps"] = test_hashmaps;
   libunittests["hexbinary"] = test_hexbinary;
@@ -51,6 +52,8 @@ void initializeTestList()
   libunittests["icu_streambuf"] = test_icu_streambuf;
 #endif /* ZORBA_NO_ICU */
 
+  libunittests["item_hash"] = test_item_hash;
+
   libunittests["mem_sizeof"] = test_mem_sizeof;
 
   libunittests["json_parser"] = test_json_parser;
@@ -30,6 +30,27 @@ namespace ascii {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+char const* find_non_ascii( char const *begin, char const *end ) {
+  typedef size_t word_type;
+  word_type const high_bits = ~static_cast<word_type>( 0 ) / 0xFF * 0x80;
+
+  //
+  // Check 4 words at a time while no non-ASCII byte is found; memcpy(3) is
+  // used for the loads since begin need not be aligned.
+  //
+  while ( end - begin >= static_cast<ptrdiff_t>( 4 * sizeof( word_type ) ) ) {
+    word_type w[4];
+    ::memcpy( w, begin, sizeof w );
+    if ( (w[0] | w[1] | w[2] | w[3]) & high_bits )
+      break;
+    begin += sizeof w;
+  }
+  for ( ; begin < end; ++begin )
+    if ( static_cast<unsigned char>( *begin ) & 0x80 )
+      break;
+  return begin;
+}
+
 bool is_space( char const *s ) {
   for ( ; *s; ++s ) {
     if ( !is_space( *s ) )
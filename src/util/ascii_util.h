@@ -111,6 +111,28 @@ is_ascii( CharType c ) {
 #endif
 }
 
+/**
+ * Gets a pointer to the first non-ASCII byte of the given byte sequence.  The
+ * bytes are checked a machine word at a time, so this is much faster than
+ * checking them one at a time with is_ascii().
+ *
+ * @param begin A pointer to the first byte.
+ * @param end A pointer to one past the last byte.
+ * @return Returns said pointer or \a end if all bytes are ASCII.
+ */
+char const* find_non_ascii( char const *begin, char const *end );
+
+/**
+ * Checks whether all the bytes of the given byte sequence are ASCII.
+ *
+ * @param s A pointer to the first byte.
+ * @param s_len The number of bytes.
+ * @return Returns \c true only if all the bytes are ASCII.
+ */
+inline bool is_ascii( char const *s, size_type s_len ) {
+  return find_non_ascii( s, s + s_len ) == s + s_len;
+}
+
 /**
  * Checks whether the given character is an alphabetic character.  This
  * function exists to make a proper function out of the standard isalpha(3)
@@ -20,18 +20,23 @@
 #ifndef ZORBA_NO_ICU
 
 #include <cstring>
+#include <list>
 #include <vector>
 
 #include <zorba/diagnostic_list.h>
 #include <zorba/internal/cxx_util.h>
 
+#include "common/common.h"
 #include "diagnostics/assert.h"
 #include "diagnostics/dict.h"
 #include "diagnostics/xquery_exception.h"
+#include "zorbautils/mutex.h"
 
 #include "ascii_util.h"
+#include "atomic_int.h"
 #include "regex.h"
 #include "stl_util.h"
+#include "unordered_map.h"
 
 #define INVALID_RE_EXCEPTION(...) \
   XQUERY_EXCEPTION( err::FORX0002, ERROR_PARAMS( __VA_ARGS__ ) )
@@ -630,24 +635,205 @@ unescaped_char:
 
 namespace unicode {
 
+/**
+ * A compiled ICU pattern shared by the cache and every %regex whose matcher
+ * was created from it.  ICU patterns are immutable once compiled, so matchers
+ * in different threads can use the same one.  It's deleted when its last
+ * reference is released.
+ */
+class cached_pattern {
+public:
+  /**
+   * Constructs a %cached_pattern with a reference count of 1.
+   *
+   * @param pattern The compiled pattern to take ownership of.
+   */
+  cached_pattern( RegexPattern *pattern ) : pattern_( pattern ) {
+    ref_count_ = 1;
+  }
+
+  RegexPattern const& pattern() const { return *pattern_; }
+
+  void add_ref() { ++ref_count_; }
+
+  void release() {
+    if ( --ref_count_ == 0 )
+      delete this;
+  }
+
+private:
+  RegexPattern *const pattern_;
+#ifdef ZORBA_FOR_ONE_THREAD_ONLY
+  long ref_count_;
+#else
+  atomic_int ref_count_;
+#endif /* ZORBA_FOR_ONE_THREAD_ONLY */
+
+  ~cached_pattern() { delete pattern_; }
+};
+
+static void throw_invalid_re( UErrorCode status, char const *pattern ) {
+  zstring icu_error_key;
+  if ( status > U_REGEX_ERROR_START && status < U_REGEX_ERROR_LIMIT ) {
+    icu_error_key = ZED_PREFIX;
+    icu_error_key += u_errorName( status );
+  }
+  throw INVALID_RE_EXCEPTION( pattern, icu_error_key );
+}
+
+/**
+ * A bounded cache of compiled patterns keyed by pattern and flags.  When full,
+ * the least recently used pattern is evicted.
+ */
+class pattern_cache {
+public:
+  ~pattern_cache() { clear(); }
+
+  /**
+   * The maximum number of patterns kept.
+   */
+  static size_t const MAX_SIZE = 256;
+
+  /**
+   * Gets the compiled form of a pattern, compiling and caching it if needed.
+   *
+   * @param u_pattern The ICU regular expression pattern.
+   * @param icu_flags The ICU regular expression flags.
+   * @param pattern The original pattern (for error messages only).
+   * @return Returns said compiled pattern with a reference added on behalf of
+   * the caller.
+   * @throws err:FORX0002 if the regular expression is invalid.
+   */
+  cached_pattern* get( string const &u_pattern, icu_flags_type icu_flags,
+                       char const *pattern );
+
+  void clear();
+
+private:
+  struct key_type {
+    string pattern;
+    icu_flags_type flags;
+
+    key_type( string const &p, icu_flags_type f ) : pattern( p ), flags( f ) {
+    }
+
+    bool operator==( key_type const &k ) const {
+      return flags == k.flags && pattern == k.pattern;
+    }
+  };
+
+  struct key_hash {
+    size_t operator()( key_type const &k ) const {
+      return static_cast<size_t>( k.pattern.hashCode() ) * 31 + k.flags;
+    }
+  };
+
+  typedef std::list<key_type> lru_list;
+
+  struct entry {
+    cached_pattern *pattern;            // holds one reference
+    lru_list::iterator lru_pos;
+  };
+
+  typedef std::unordered_map<key_type,entry,key_hash> map_type;
+
+  map_type map_;
+  lru_list lru_;                        // most recently used first
+  SYNC_CODE( Mutex mutex_; )
+};
+
+cached_pattern*
+pattern_cache::get( string const &u_pattern, icu_flags_type icu_flags,
+                    char const *pattern ) {
+  key_type const key( u_pattern, icu_flags );
+  {
+    SYNC_CODE( AutoMutex const lock( &mutex_ ); )
+    map_type::iterator const i = map_.find( key );
+    if ( i != map_.end() ) {
+      lru_.splice( lru_.begin(), lru_, i->second.lru_pos );
+      i->second.pattern->add_ref();
+      return i->second.pattern;
+    }
+  }
+
+  //
+  // Compile outside the lock: if two threads race to compile the same
+  // pattern, the loser's copy simply replaces the winner's.
+  //
+  UErrorCode status = U_ZERO_ERROR;
+  RegexPattern *const p = RegexPattern::compile( u_pattern, icu_flags, status );
+  if ( U_FAILURE( status ) ) {
+    delete p;
+    throw_invalid_re( status, pattern );
+  }
+  cached_pattern *const result = new cached_pattern( p );
+  result->add_ref();                    // one for the caller, one for the map
+
+  SYNC_CODE( AutoMutex const lock( &mutex_ ); )
+  map_type::iterator i = map_.find( key );
+  if ( i == map_.end() ) {
+    if ( map_.size() >= MAX_SIZE ) {
+      map_type::iterator const lru = map_.find( lru_.back() );
+      lru->second.pattern->release();
+      map_.erase( lru );
+      lru_.pop_back();
+    }
+    lru_.push_front( key );
+    i = map_.insert( make_pair( key, entry() ) ).first;
+  } else {
+    i->second.pattern->release();
+    lru_.splice( lru_.begin(), lru_, i->second.lru_pos );
+  }
+  i->second.pattern = result;
+  i->second.lru_pos = lru_.begin();
+  return result;
+}
+
+void pattern_cache::clear() {
+  SYNC_CODE( AutoMutex const lock( &mutex_ ); )
+  FOR_EACH( map_type, i, map_ )
+    i->second.pattern->release();
+  map_.clear();
+  lru_.clear();
+}
+
+static pattern_cache& get_pattern_cache() {
+  static pattern_cache cache;
+  return cache;
+}
+
+regex::~regex() {
+  delete matcher_;
+  if ( pattern_ )
+    pattern_->release();
+}
+
+void regex::clear_cache() {
+  get_pattern_cache().clear();
+}
+
 void regex::compile( string const &u_pattern, char const *flags,
                      char const *pattern ) {
   icu_flags_type const icu_flags =
     convert_xquery_flags( flags ) & ~UREGEX_LITERAL;
   delete matcher_;
+  matcher_ = nullptr;
+  if ( pattern_ ) {
+    pattern_->release();
+    pattern_ = nullptr;
+  }
+
+  cached_pattern *const cp =
+    get_pattern_cache().get( u_pattern, icu_flags, pattern );
   UErrorCode status = U_ZERO_ERROR;
-  matcher_ = new RegexMatcher( u_pattern, icu_flags, status );
+  matcher_ = cp->pattern().matcher( status );
   if ( U_FAILURE( status ) ) {
     delete matcher_;
     matcher_ = nullptr;
-
-    zstring icu_error_key;
-    if ( status > U_REGEX_ERROR_START && status < U_REGEX_ERROR_LIMIT ) {
-      icu_error_key = ZED_PREFIX;
-      icu_error_key += u_errorName( status );
-    }
-    throw INVALID_RE_EXCEPTION( pattern, icu_error_key );
+    cp->release();
+    throw_invalid_re( status, pattern );
   }
+  pattern_ = cp;
 }
 
 int regex::get_group_count() const {
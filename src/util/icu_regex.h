@@ -43,22 +43,32 @@ void convert_xquery_re( zstring const &xq_re, zstring *lib_re,
 
 namespace unicode {
 
+class cached_pattern;
+
 /**
  * The %regex class wraps the underlying Unicode regular expression library.
+ *
+ * Compiled patterns are kept in a bounded, process-wide cache keyed by pattern
+ * and flags: compiling a pattern that was compiled recently (by any %regex in
+ * any thread) only creates a new matcher for it.
  */
 class regex {
 public:
   /**
    * Constructs a %regex.
    */
-  regex() : matcher_( nullptr ) { }
+  regex() : matcher_( nullptr ), pattern_( nullptr ) { }
 
   /**
    * Destroys a %regex.
    */
-  ~regex() {
-    delete matcher_;
-  }
+  ~regex();
+
+  /**
+   * Empties the cache of compiled patterns.  Patterns still in use by some
+   * %regex are freed once they're no longer used.
+   */
+  static void clear_cache();
 
   ////////// compile pattern //////////////////////////////////////////////////
 
@@ -488,6 +498,7 @@ public:
 
 private:
   U_NAMESPACE_QUALIFIER RegexMatcher *matcher_;
+  cached_pattern *pattern_;
   string s_;
 
   enum re_type_t {
@@ -32,6 +32,7 @@
 #include "diagnostics/assert.h"
 #include "diagnostics/diagnostic.h"
 #include "diagnostics/zorba_exception.h"
+#include "util/ascii_util.h"
 #include "util/string_util.h"
 #include "util/utf8_util.h"
 
@@ -61,7 +62,8 @@ icu_streambuf::icu_streambuf( char const *charset, streambuf *orig ) :
   internal::proxy_streambuf( orig ),
   no_conv_( !is_necessary( charset ) ),
   external_conv_( no_conv_ ? nullptr : create_conv( charset ) ),
-  utf8_conv_( no_conv_ ? nullptr : create_conv( "UTF-8" ) )
+  utf8_conv_( no_conv_ ? nullptr : create_conv( "UTF-8" ) ),
+  ascii_compat_( !no_conv_ && is_ascii_compatible( external_conv_ ) )
 {
   if ( !orig )
     throw invalid_argument( "null streambuf" );
@@ -102,6 +104,51 @@ UConverter* icu_streambuf::create_conv( char const *charset ) {
   return conv;
 }
 
+/**
+ * Checks whether the given converter's encoding is a single-byte encoding that
+ * has no state and whose bytes 0-127 are the ASCII characters.  (EBCDIC, for
+ * example, is single-byte but not ASCII compatible.)  For such an encoding, a
+ * buffer of only ASCII bytes is the same in the encoding and in UTF-8 and need
+ * not be converted.
+ */
+bool icu_streambuf::is_ascii_compatible( UConverter *conv ) {
+  switch ( ucnv_getType( conv ) ) {
+    case UCNV_SBCS:
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+      break;
+    default:
+      return false;
+  }
+
+  UChar u[ 128 ], u2[ 128 ];
+  char c[ 128 ];
+  for ( int i = 0; i < 128; ++i )
+    u[i] = static_cast<UChar>( i );
+
+  UErrorCode err = U_ZERO_ERROR;
+  int32_t const c_len = ucnv_fromUChars( conv, c, sizeof c, u, 128, &err );
+  int32_t const u_len = ucnv_toUChars( conv, u2, 128, c, c_len, &err );
+  ucnv_reset( conv );
+  if ( U_FAILURE( err ) || c_len != 128 || u_len != 128 )
+    return false;
+
+  for ( int i = 0; i < 128; ++i )
+    if ( c[i] != static_cast<char>( i ) || u2[i] != u[i] )
+      return false;
+  return true;
+}
+
+/**
+ * Checks whether no UTF-8 input is pending conversion to the external encoding,
+ * i.e., whether the next bytes written start at a character boundary.
+ */
+bool icu_streambuf::p_empty() const {
+  UErrorCode err = U_ZERO_ERROR;
+  return p_.pivot_source_ == p_.pivot_target_ &&
+         ucnv_toUCountPending( utf8_conv_, &err ) == 0 && U_SUCCESS( err );
+}
+
 bool icu_streambuf::is_necessary( char const *cc_charset ) {
   if ( !*cc_charset )
     throw invalid_argument( "empty charset" );
@@ -161,6 +208,8 @@ icu_streambuf::int_type icu_streambuf::overflow( int_type c ) {
     return traits_type::eof();
 
   char_type const utf8_byte = traits_type::to_char_type( c );
+  if ( ascii_compat_ && ascii::is_ascii( utf8_byte ) && p_empty() )
+    return original()->sputc( utf8_byte );
   char_type const *from = &utf8_byte;
   char ebuf[ Small_External_Buf_Size ], *to = ebuf;
 
@@ -291,7 +340,13 @@ streamsize icu_streambuf::xsgetn( char_type *to, streamsize size ) {
       char_type const *const to_orig = to;
       int_type const peek = original()->sgetc();
       bool const flush = traits_type::eq_int_type( peek, traits_type::eof() );
-      to_utf8( &from, from + got, &to, to_end, flush );
+      if ( ascii_compat_ && g_.pivot_source_ == g_.pivot_target_ &&
+           ascii::is_ascii( ebuf, static_cast<ascii::size_type>( got ) ) ) {
+        // ASCII bytes are the same in UTF-8: copy them as they are.
+        traits_type::copy( to, ebuf, static_cast<size_t>( got ) );
+        to += got;
+      } else
+        to_utf8( &from, from + got, &to, to_end, flush );
       streamsize const n = to - to_orig;
       size -= n, return_size += n;
       if ( flush )
@@ -309,6 +364,13 @@ streamsize icu_streambuf::xsputn( char_type const *from, streamsize size ) {
   if ( no_conv_ )
     return original()->sputn( from, size );
 
+  if ( ascii_compat_ &&
+       ascii::is_ascii( from, static_cast<ascii::size_type>( size ) ) &&
+       p_empty() ) {
+    // ASCII bytes are the same in the external encoding: write them as is.
+    return original()->sputn( from, size );
+  }
+
   streamsize return_size = 0;
   char_type const *const from_end = from + size;
   char ebuf[ Large_External_Buf_Size ], *to = ebuf;
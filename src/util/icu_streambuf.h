@@ -122,9 +122,12 @@ private:
 
   bool const no_conv_;                  // true = no conversion needed
   UConverter *const external_conv_, *const utf8_conv_;
+  bool const ascii_compat_;             // true = ASCII bytes need no conversion
 
   void clear();
   static UConverter* create_conv( char const *charset );
+  static bool is_ascii_compatible( UConverter *conv );
+  bool p_empty() const;
   void resetg();
 
   bool to_external( char_type const **from, char_type const *from_end,
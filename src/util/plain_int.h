@@ -0,0 +1,88 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ * 
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ * http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#ifndef PLAIN_INT_H
+#define PLAIN_INT_H
+
+#include "util/atomic_int.h"
+
+namespace zorba {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A %plain_int has the same API and layout as atomic_int except that its
+ * modifications and accesses are ordinary, non-atomic ones.  It is meant for
+ * reference counts of objects that are never shared between threads.
+ */
+class plain_int {
+public:
+  typedef atomic_int::value_type value_type;
+
+  explicit plain_int( value_type n = 0 ) : value_( n ) {
+  }
+
+  plain_int& operator=( value_type n ) {
+    value_ = n;
+    return *this;
+  }
+
+  value_type load() const {
+    return value_;
+  }
+
+  void store( value_type n ) {
+    value_ = n;
+  }
+
+  value_type operator++() {
+    return ++value_;
+  }
+
+  value_type operator++(int) {
+    return value_++;
+  }
+
+  value_type operator--() {
+    return --value_;
+  }
+
+  value_type operator--(int) {
+    return value_--;
+  }
+
+  value_type operator+=( value_type n ) {
+    return value_ += n;
+  }
+
+  value_type operator-=( value_type n ) {
+    return value_ -= n;
+  }
+
+private:
+  value_type value_;
+
+  // forbid for compatibility with atomic_int
+  plain_int( plain_int const& );
+  plain_int& operator=( plain_int& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace zorba
+
+#endif /* PLAIN_INT_H */
+/* vim:set et sw=2 ts=2: */
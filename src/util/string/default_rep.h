@@ -18,6 +18,7 @@
 #define ZORBA_RSTRING_DEFAULT_REP_H
 
 #include <cassert>
+#include <cstddef>                      /* for offsetof */
 #include <iterator>
 
 #include <zorba/internal/cxx_util.h>
@@ -133,7 +134,7 @@ public:
    * @param a The allocator that was used to create this %rep.
    */
   void dispose( allocator_type const &a ) {
-    if ( this != empty_rep() && this->dec() < 0 ) {
+    if ( !this->is_static() && this->dec() < 0 ) {
       raw_allocator( a ).deallocate(
         reinterpret_cast<char*>( this ), raw_size( this->capacity() )
       );
@@ -154,6 +155,24 @@ public:
     return reinterpret_cast<rep*>( empty_rep_base::empty_rep() );
   }
 
+  /**
+   * Gets the shared %rep for the string containing only the given character.
+   *
+   * @param c The character.
+   * @return Returns said %rep or \c nullptr if there is none for \a c.
+   */
+  static rep* char_rep( value_type c ) {
+    static_assert(
+      sizeof( rep ) == offsetof( empty_rep_base::char_rep_model, data_ ),
+      "layout of single-character string representation does not match"
+    );
+    if ( sizeof( value_type ) != sizeof( char ) )
+      return nullptr;
+    return reinterpret_cast<rep*>(
+      empty_rep_base::char_rep( static_cast<unsigned char>( c ) )
+    );
+  }
+
   /**
    * Reserves a minimum capacity.
    *
@@ -86,6 +86,10 @@ construct( ForwardIterator begin, ForwardIterator end, allocator_type const &a,
   if ( !begin && begin != end )
     throw std::logic_error( "NULL not valid" );
   size_type const len = static_cast<size_type>( std::distance( begin, end ) );
+  if ( len == 1 && a == allocator_type() ) {
+    if ( rep *const r = char_rep( *begin ) )
+      return r;
+  }
   rep *const r = alloc( a, len );
   try {
     copy_chars( r->data(), begin, end );
@@ -26,6 +26,23 @@ namespace rstring_classes {
 
 char empty_rep_base::empty_rep_storage_[ sizeof( rep_model ) ];
 
+// A reference-count of 1 marks the representations as shared.
+#define CHAR_REP(C)     { 1, 1, 1, { static_cast<char>( C ), '\0' } }
+#define CHAR_REP_4(C)   CHAR_REP(C), CHAR_REP(C+1), CHAR_REP(C+2), CHAR_REP(C+3)
+#define CHAR_REP_16(C)  CHAR_REP_4(C), CHAR_REP_4(C+4), CHAR_REP_4(C+8), \
+                        CHAR_REP_4(C+12)
+#define CHAR_REP_64(C)  CHAR_REP_16(C), CHAR_REP_16(C+16), CHAR_REP_16(C+32), \
+                        CHAR_REP_16(C+48)
+
+empty_rep_base::char_rep_model empty_rep_base::char_rep_storage_[ 256 ] = {
+  CHAR_REP_64(0), CHAR_REP_64(64), CHAR_REP_64(128), CHAR_REP_64(192)
+};
+
+#undef CHAR_REP
+#undef CHAR_REP_4
+#undef CHAR_REP_16
+#undef CHAR_REP_64
+
 } // namespace rstring_classes
 } // namespace zorba
 /* vim:set et sw=2 ts=2: */
@@ -61,6 +61,17 @@ protected:
     } derived_reps;
   };
 
+  /**
+   * A %char_rep_model models the data of a default string representation
+   * containing a single character.
+   */
+  struct char_rep_model {
+    atomic_int::value_type  count_;
+    size_t                  cap_;
+    size_t                  len_;
+    char                    data_[2];
+  };
+
   empty_rep_base() {
     // This is defined to prevent naked instance creation.
   }
@@ -74,8 +85,35 @@ protected:
     return static_cast<void*>( empty_rep_storage_ );
   }
 
+  /**
+   * Gets a pointer to the shared string representation of the given single
+   * character.  These representations are permanently marked as shared, so a
+   * string using one of them always copies it before modifying it.
+   *
+   * @param c The character.
+   * @return Returns said string representation.
+   */
+  static void* char_rep( unsigned char c ) {
+    return static_cast<void*>( char_rep_storage_ + c );
+  }
+
+  /**
+   * Checks whether the given string representation is one of the statically
+   * allocated ones, i.e., the empty one or a single-character one.  These are
+   * neither reference-counted nor ever deallocated.
+   *
+   * @param r The string representation to check.
+   * @return Returns \c true only if it is.
+   */
+  static bool is_static_rep( void const *r ) {
+    char_rep_model const *const m = static_cast<char_rep_model const*>( r );
+    return r == empty_rep_storage_ ||
+      (m >= char_rep_storage_ && m < char_rep_storage_ + 256);
+  }
+
 private:
   static char empty_rep_storage_[];
+  static char_rep_model char_rep_storage_[];
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -165,6 +203,16 @@ public:
 
   ////////// reference-count functions ////////////////////////////////////////
 
+  /**
+   * Checks whether this representation is statically allocated, in which case
+   * it must be neither reference-counted nor deallocated.
+   *
+   * @return Returns \c true only if it is.
+   */
+  bool is_static() const {
+    return empty_rep_base::is_static_rep( this );
+  }
+
   count_type count() const {
     return this->load();
   }
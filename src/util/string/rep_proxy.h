@@ -118,7 +118,7 @@ public:
               allocator_type const &that_alloc ) {
     dispose( this_alloc );
     if ( that.rep_->is_sharable() && this_alloc == that_alloc ) {
-      if ( that.rep_ != RepType::empty_rep() )
+      if ( !that.rep_->is_static() )
         that.rep_->inc();
       set_rep( that.rep_ );
     } else {
@@ -162,6 +162,8 @@ template<class Rep> int
 rstring<Rep>::compare( rstring const &s ) const {
   size_type const len = size();
   size_type const s_len = s.size();
+  if ( data() == s.data() && len == s_len )
+    return 0;                           // e.g., strings sharing their rep
   size_type const n = std::min( len, s_len );
   int const comp = traits_type::compare( data(), s.data(), n );
   return comp ? comp : compare( len, s_len );
@@ -84,10 +84,19 @@ size_type byte_pos( storage_type const *s, size_type s_len,
     return npos;
   storage_type const *p = s;
   storage_type const *const end = s + s_len;
-  for ( ; char_pos > 0; --char_pos ) {
+  while ( char_pos > 0 ) {
     if ( p >= end )
       return npos;
-    p += char_length( *p );
+    // ASCII characters are 1 byte each: skip a run of them at once.
+    storage_type const *const q = ascii::find_non_ascii(
+      p, p + std::min( char_pos, static_cast<size_type>( end - p ) )
+    );
+    char_pos -= q - p;
+    p = q;
+    if ( char_pos > 0 && p < end ) {
+      p += char_length( *p );
+      --char_pos;
+    }
   }
   return p - s;
 }
@@ -120,8 +129,13 @@ size_type char_length( storage_type start ) {
 size_type char_pos( storage_type const *s, storage_type const *p ) {
   size_type pos = 0;
   while ( s < p ) {
-    s += char_length( *s );
-    ++pos;
+    storage_type const *const q = ascii::find_non_ascii( s, p );
+    pos += q - s;
+    s = q;
+    if ( s < p ) {
+      s += char_length( *s );
+      ++pos;
+    }
   }
   return pos;
 }
@@ -200,19 +214,21 @@ storage_type* itou( unsigned long long n, storage_type *buf,
 }
 
 size_type length( storage_type const *s ) {
-  size_type total_len = 0;
-  while ( *s ) {
-    s += char_length( *s );
-    ++total_len;
-  }
-  return total_len;
+  return length( s, s + std::strlen( s ) );
 }
 
 size_type length( storage_type const *begin, storage_type const *end ) {
   size_type total_len = 0;
-  while ( begin < end && *begin ) {
-    begin += char_length( *begin );
-    ++total_len;
+  while ( begin < end ) {
+    storage_type const *const q = ascii::find_non_ascii( begin, end );
+    if ( void const *const nul = std::memchr( begin, '\0', q - begin ) )
+      return total_len + (static_cast<storage_type const*>( nul ) - begin);
+    total_len += q - begin;
+    begin = q;
+    if ( begin < end ) {
+      begin += char_length( *begin );
+      ++total_len;
+    }
   }
   return total_len;
 }
@@ -316,11 +332,13 @@ storage_type const* validate( storage_type const *s ) {
 }
 
 storage_type const* validate( storage_type const *s, size_type s_len ) {
+  storage_type const *const end = s + s_len;
   try {
-    for ( ; s_len; ++s, --s_len ) {
+    while ( (s = ascii::find_non_ascii( s, end )) < end ) {
       for ( size_type c_len = char_length( *s ); --c_len; )
-        if ( !--s_len || !is_continuation_byte( *++s ) )
+        if ( s + 1 == end || !is_continuation_byte( *++s ) )
           return s;
+      ++s;
     }
     return nullptr;
   }
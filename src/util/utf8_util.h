@@ -19,8 +19,10 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <cwchar>
 #include <string>
+#include <vector>
 
 #include <zorba/internal/cxx_util.h>
 
@@ -915,6 +917,11 @@ compare(const StringType1 &s1, const StringType2 &s2,
   if (collation == NULL || collation->doMemCmp())
     return s1.compare(s2);
 
+  // Identical byte sequences, e.g., interned values, are equal under any
+  // collation.
+  if (s1.data() == s2.data() && s1.size() == s2.size())
+    return 0;
+
   unicode::string us1;
   unicode::string us2;
 
@@ -939,16 +946,22 @@ hash(const StringType& s, const XQPCollator* collation = NULL)
   if (!collation || collation->doMemCmp())
 #endif
   {
+    // djb2 (hash = hash * 33 + c) over the characters up to the first NUL.
+    // The main loop consumes 4 characters per iteration using the powers of
+    // 33, so its multiplications do not depend on each other.
     const char* str = s.data();
-    ulong len = (ulong)s.size();
+    const char* end = str + s.size();
+    if (const void* nul = std::memchr(str, 0, s.size()))
+      end = static_cast<const char*>(nul);
+
     uint32_t hash = 5381;
-    ulong i = 0;
-    int c;
-    while (i < len && (c = *str++))
+    for (; end - str >= 4; str += 4)
     {
-      hash = ((hash << 5) + hash) + c;
-      ++i;
+      hash = hash * 1185921u +
+             str[0] * 35937u + str[1] * 1089u + str[2] * 33u + str[3];
     }
+    for (; str < end; ++str)
+      hash = hash * 33u + *str;
     return hash;
     //return hashfun::h32((void*)(s.data()), s.size());
   }
@@ -974,6 +987,53 @@ hash(const StringType& s, const XQPCollator* collation = NULL)
 #endif /* ZORBA_NO_ICU */
 }
 
+/**
+ * Computes the sort key of a string under a collation, i.e., a byte string
+ * such that comparing the sort keys of two strings byte-wise gives the same
+ * result as comparing the strings themselves under the collation.  When the
+ * same strings are compared many times, e.g., when sorting, it is cheaper to
+ * compute their sort keys once and compare those.
+ *
+ * @param s The string.
+ * @param collation The collation.  It must not be \c null.
+ * @param key The string to receive the sort key.  The key includes a
+ * terminating NUL byte (that does not occur elsewhere in it), so it is never
+ * empty.
+ */
+template<class StringType,class KeyStringType>
+typename std::enable_if<ZORBA_IS_STRING(StringType)
+                     && ZORBA_IS_STRING(KeyStringType),
+                        void>::type
+sort_key(const StringType& s, const XQPCollator* collation, KeyStringType* key)
+{
+#ifndef ZORBA_NO_ICU
+  if (!collation->doMemCmp())
+  {
+    unicode::string us;
+    unicode::to_string(s, &us);
+
+    Collator const *const coll =
+      static_cast<Collator*>(collation->getCollator());
+
+    uint8_t buf[256];
+    int32_t const len = coll->getSortKey(us, buf, sizeof buf);
+    if (len <= static_cast<int32_t>(sizeof buf))
+    {
+      key->assign(reinterpret_cast<char*>(buf), len);
+    }
+    else
+    {
+      std::vector<uint8_t> big(len);
+      coll->getSortKey(us, &big[0], len);
+      key->assign(reinterpret_cast<char*>(&big[0]), len);
+    }
+    return;
+  }
+#endif /* ZORBA_NO_ICU */
+  key->assign(s.data(), s.size());
+  key->push_back('\0');
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 } // namespace utf8
@@ -296,6 +296,7 @@ enum TypeCode
   TYPE_PrecedingAxisIterator,
   TYPE_PrecedingReverseAxisIterator,
   TYPE_FollowingAxisIterator,
+  TYPE_DescendantPathIterator,
 
   TYPE_MaterializeIterator,
 
@@ -104,7 +104,15 @@ INSTANTIATE_INTEGER( PositiveInteger );
 ********************************************************************************/
 void operator&(Archiver& ar, Decimal& obj)
 {
-  ar & obj.value_;
+  Decimal::value_type value;
+
+  if (ar.is_serializing_out())
+    value = obj.value();
+
+  ar & value;
+
+  if (!ar.is_serializing_out())
+    obj.set(value);
 }
 
 
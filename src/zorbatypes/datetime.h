@@ -355,6 +355,8 @@ public:
   int getDayOfYear() const;
 
 protected:
+  void getNormalizedData(long tz_seconds, long ndata[7]) const;
+
   Duration* toDayTimeDuration() const;
 
   void adjustToFacet();
@@ -852,13 +852,36 @@ int DateTime::parse_time(
 
   if (position < len && str[position] == '.')
   {
-    double temp_frac_seconds;
-    position++;
+    ascii::size_type const start = ++position;
+    ascii::size_type digits;
 
-    if ((err = parse_frac(str, len, position, temp_frac_seconds)))
-      return err;
+    // Up to 6 digits, i.e., microseconds, are accumulated exactly.
+    frac_seconds = 0;
+    while (position < len && position - start < 6 && ascii::is_digit(str[position]))
+    {
+      frac_seconds = frac_seconds * 10 + (str[position] - '0');
+      ++position;
+    }
+
+    if (position == start)
+      return 1;
+
+    if (position < len && ascii::is_digit(str[position]))
+    {
+      // more digits than can be represented: round
+      double temp_frac_seconds;
+      position = start;
 
-    frac_seconds = round(temp_frac_seconds * FRAC_SECONDS_UPPER_LIMIT);
+      if ((err = parse_frac(str, len, position, temp_frac_seconds)))
+        return err;
+
+      frac_seconds = round(temp_frac_seconds * FRAC_SECONDS_UPPER_LIMIT);
+    }
+    else
+    {
+      for (digits = position - start; digits < 6; ++digits)
+        frac_seconds *= 10;
+    }
   }
   else
   {
@@ -1045,18 +1068,18 @@ bool DateTime::hasTimezone() const
 
 int DateTime::compare(const DateTime* dt, long timezone_seconds) const
 {
-  std::unique_ptr<DateTime> d1_t;
-  std::unique_ptr<DateTime> d2_t;
+  long d1[7];
+  long d2[7];
 
-  d1_t.reset(normalizeTimeZone(timezone_seconds));
-  d2_t.reset(dt->normalizeTimeZone(timezone_seconds));
+  getNormalizedData(timezone_seconds, d1);
+  dt->getNormalizedData(timezone_seconds, d2);
 
   // compare the rest of the data
   for (int i=0; i<7; i++)
   {
-    if (d1_t->data[i] < d2_t->data[i])
+    if (d1[i] < d2[i])
       return -1;
-    else if (d1_t->data[i] > d2_t->data[i])
+    else if (d1[i] > d2[i])
       return 1;
   }
 
@@ -1067,18 +1090,21 @@ int DateTime::compare(const DateTime* dt, long timezone_seconds) const
 uint32_t DateTime::hash(int implicit_timezone_seconds) const
 {
   uint32_t hval = 0;
-  std::unique_ptr<DateTime> dt(normalizeTimeZone(implicit_timezone_seconds));
+  long ndata[7];
 
-  hval = hashfun::h32<int>((int)dt->facet, hval);
-  hval = hashfun::h32<int>(dt->data[YEAR_DATA], hval);
-  hval = hashfun::h32<int>(dt->data[MONTH_DATA], hval);
-  hval = hashfun::h32<int>(dt->data[DAY_DATA], hval);
-  hval = hashfun::h32<int>(dt->data[HOUR_DATA], hval);
-  hval = hashfun::h32<int>(dt->data[MINUTE_DATA], hval);
-  hval = hashfun::h32<int>(dt->data[SECONDS_DATA], hval);
-  hval = hashfun::h32<int>(dt->data[FRACSECONDS_DATA], hval);
+  getNormalizedData(implicit_timezone_seconds, ndata);
 
-  hval *= dt->the_time_zone.hash();
+  hval = hashfun::h32<int>((int)facet, hval);
+  hval = hashfun::h32<int>(ndata[YEAR_DATA], hval);
+  hval = hashfun::h32<int>(ndata[MONTH_DATA], hval);
+  hval = hashfun::h32<int>(ndata[DAY_DATA], hval);
+  hval = hashfun::h32<int>(ndata[HOUR_DATA], hval);
+  hval = hashfun::h32<int>(ndata[MINUTE_DATA], hval);
+  hval = hashfun::h32<int>(ndata[SECONDS_DATA], hval);
+  hval = hashfun::h32<int>(ndata[FRACSECONDS_DATA], hval);
+
+  // the normalized DateTime is in UTC
+  hval *= TimeZone(0).hash();
 
   return hval;
 }
@@ -1215,6 +1241,97 @@ Duration* DateTime::subtractDateTime(
 }
 
 
+/*******************************************************************************
+  Computes the data of normalizeTimeZone(tz_seconds) without creating any
+  DateTime or Duration objects. This is the algorithm of addDuration() for the
+  case of a duration of less than a day, which is all a timezone can be.
+********************************************************************************/
+void DateTime::getNormalizedData(long tz_seconds, long ndata[7]) const
+{
+  long offset;
+
+  if (!the_time_zone)
+  {
+    // validate timezone value (-14 .. +14 H)
+    if (tz_seconds > 14*3600 || tz_seconds < -14*3600)
+      throw InvalidTimezoneException( tz_seconds );
+
+    offset = tz_seconds;
+  }
+  else
+  {
+    offset = the_time_zone.gmtoff();
+  }
+
+  // The duration to add is -offset.
+  int const d_hours = static_cast<int>(-offset / 3600);
+  int const d_minutes = static_cast<int>(-offset / 60 % 60);
+  int const d_seconds = static_cast<int>(-offset % 60);
+
+  int years, months, days, hours, minutes, int_seconds, frac_seconds, temp_days, carry;
+  int total_seconds;
+
+  months = modulo<int>(data[MONTH_DATA] - 1, 12) + 1;
+
+  years = data[YEAR_DATA] + quotient<int>(data[MONTH_DATA] - 1, 12);
+
+  total_seconds = data[SECONDS_DATA] + d_seconds + quotient<int>(data[FRACSECONDS_DATA], DateTime::FRAC_SECONDS_UPPER_LIMIT);
+  int_seconds = modulo<int>(total_seconds, 60);
+
+  frac_seconds = modulo<int>(data[FRACSECONDS_DATA], DateTime::FRAC_SECONDS_UPPER_LIMIT);
+
+  minutes = data[MINUTE_DATA] + d_minutes + quotient<int>(total_seconds, 60);
+
+  hours = data[HOUR_DATA] + d_hours + quotient<int>(minutes, 60);
+
+  minutes = modulo<int>(minutes, 60);
+
+  carry = quotient<int>(hours, 24);
+
+  hours = modulo<int>(hours, 24);
+
+  if (data[DAY_DATA] > get_last_day(years, months))
+    temp_days = get_last_day(years, months);
+  else if (data[DAY_DATA] < 1)
+    temp_days = 1;
+  else
+    temp_days = data[DAY_DATA];
+
+  days = temp_days + carry;
+  while (1)
+  {
+    if (days <1)
+    {
+      days = days + get_last_day(years,months-1);
+      carry = -1;
+    }
+    else if (days > get_last_day(years, months))
+    {
+      days = days - get_last_day(years, months);
+      carry = 1;
+    }
+    else
+      break;
+
+    years += quotient<int>(months + carry-1, 12);
+    months = modulo<int>(months + carry -1, 12) + 1;
+  }
+
+  if (data[YEAR_DATA] > 0 && offset > 0 && years <= 0)
+    years--;
+  if (data[YEAR_DATA] < 0 && offset < 0 && years >= 0)
+    years++;
+
+  ndata[YEAR_DATA] = years;
+  ndata[MONTH_DATA] = months;
+  ndata[DAY_DATA] = days;
+  ndata[HOUR_DATA] = hours;
+  ndata[MINUTE_DATA] = minutes;
+  ndata[SECONDS_DATA] = int_seconds;
+  ndata[FRACSECONDS_DATA] = frac_seconds;
+}
+
+
 DateTime* DateTime::normalizeTimeZone(int tz_seconds) const
 {
   DateTime* dt;
@@ -128,9 +128,28 @@ int parse_frac( char const *str, size_t len, size_t &pos, double &result )
 
 std::string zero_pad(int value, unsigned int min_digits)
 {
-  std::ostringstream oss;
-  oss << std::setfill('0') << std::setw( min_digits ) << value;
-  return oss.str();
+  if (value < 0)
+  {
+    std::ostringstream oss;
+    oss << std::setfill('0') << std::setw( min_digits ) << value;
+    return oss.str();
+  }
+
+  char buf[16];
+  char* const end = buf + sizeof(buf);
+  char* p = end;
+
+  do
+  {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  }
+  while (value > 0);
+
+  while (static_cast<unsigned int>(end - p) < min_digits && p > buf)
+    *--p = '0';
+
+  return std::string(p, end);
 }
 
 } // namespace zorba
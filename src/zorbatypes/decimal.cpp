@@ -35,6 +35,151 @@ namespace zorba {
 
 Decimal::value_type const Decimal::round_precision_limit( 64 );
 
+static int64_t const power_of_10[] = {
+  1LL,
+  10LL,
+  100LL,
+  1000LL,
+  10000LL,
+  100000LL,
+  1000000LL,
+  10000000LL,
+  100000000LL,
+  1000000000LL,
+  10000000000LL,
+  100000000000LL,
+  1000000000000LL,
+  10000000000000LL,
+  100000000000000LL,
+  1000000000000000LL,
+  10000000000000000LL,
+  100000000000000000LL,
+  1000000000000000000LL
+};
+
+/**
+ * The largest absolute value of an intermediate unscaled fixed-point value.
+ * The smallest one is its negation, so negating a fixed-point value never
+ * overflows.  Results with more than Decimal::max_scale digits are kept in
+ * MAPM form (see Decimal::set_fixed()).
+ */
+static int64_t const fixed_max = numeric_limits<int64_t>::max();
+
+/**
+ * Adds two unscaled fixed-point values.
+ *
+ * @return Returns \c false only if the sum is out of range.
+ */
+static bool fixed_add( int64_t a, int64_t b, int64_t *result ) {
+  if ( b > 0 ? a > fixed_max - b : a < -fixed_max - b )
+    return false;
+  *result = a + b;
+  return true;
+}
+
+/**
+ * Multiplies two unscaled fixed-point values.
+ *
+ * @return Returns \c false only if the product is out of range.
+ */
+static bool fixed_mul( int64_t a, int64_t b, int64_t *result ) {
+  uint64_t const ua = a < 0 ? -a : a;
+  uint64_t const ub = b < 0 ? -b : b;
+  if ( ua && ub > static_cast<uint64_t>( fixed_max ) / ua )
+    return false;
+  *result = a * b;
+  return true;
+}
+
+/**
+ * Formats a fixed-point value in its canonical lexical form.
+ *
+ * @param n The unscaled value.
+ * @param scale The number of fractional digits.
+ * @param buf The buffer to use; it must be large enough for a sign, 2 *
+ * max_scale digits, a '.', and a null.
+ * @return Returns \a buf.
+ */
+static char* fixed_format( int64_t n, int scale, char *buf ) {
+  char digits[ 24 ];
+  char *d = digits + sizeof digits;
+  *--d = '\0';
+  uint64_t u = n < 0 ? -n : n;
+  int count = 0;
+  do {
+    *--d = static_cast<char>( '0' + u % 10 );
+    u /= 10;
+    ++count;
+  } while ( u );
+
+  char *p = buf;
+  if ( n < 0 )
+    *p++ = '-';
+  if ( count <= scale ) {
+    *p++ = '0';
+    *p++ = '.';
+    for ( int i = count; i < scale; ++i )
+      *p++ = '0';
+    ::strcpy( p, d );
+  } else {
+    int const int_digits = count - scale;
+    ::memcpy( p, d, int_digits );
+    p += int_digits;
+    if ( scale ) {
+      *p++ = '.';
+      ::strcpy( p, d + int_digits );
+    } else
+      *p = '\0';
+  }
+  return buf;
+}
+
+bool Decimal::parse_fixed( char const *s, int64_t *result, int *result_scale ) {
+  s = ascii::trim_start_space( s );
+  bool const negative = *s == '-';
+  if ( *s == '+' || *s == '-' )
+    ++s;
+  int64_t n = 0;
+  int digits = 0, scale = 0;
+  bool any_digit = false;
+  for ( ; ascii::is_digit( *s ); ++s ) {
+    any_digit = true;
+    if ( (n || *s != '0') && ++digits > max_scale )
+      return false;
+    n = n * 10 + (*s - '0');
+  }
+  if ( *s == '.' ) {
+    for ( ++s; ascii::is_digit( *s ); ++s ) {
+      any_digit = true;
+      if ( (n || *s != '0') && ++digits > max_scale )
+        return false;
+      if ( ++scale > max_scale )
+        return false;
+      n = n * 10 + (*s - '0');
+    }
+  }
+  while ( ascii::is_space( *s ) )
+    ++s;
+  if ( !any_digit || *s )
+    return false;
+  *result = negative ? -n : n;
+  *result_scale = scale;
+  return true;
+}
+
+void Decimal::parse( char const *s ) {
+  int64_t n;
+  int scale;
+  if ( parse_fixed( s, &n, &scale ) )
+    set_fixed( n, scale );
+  else {
+    // Leave anything else, including errors, to the MAPM parser.
+    value_type temp;
+    parse( s, &temp );
+    set( temp );
+  }
+}
+
 void Decimal::parse( char const *s, value_type *result, int parse_options ) {
   if ( !*s ) {
     //
@@ -145,53 +290,205 @@ void Decimal::reduce( char *s ) {
   }
 }
 
+////////// representation /////////////////////////////////////////////////////
+
+Decimal Decimal::fixed( int64_t n, int scale ) {
+  Decimal result;
+  result.set_fixed( n, scale );
+  return result;
+}
+
+/**
+ * Brings two fixed-point values to the same scale.
+ *
+ * @return Returns \c false only if that can't be done without overflow.
+ */
+bool Decimal::align( Decimal const &d1, Decimal const &d2, int64_t *n1,
+                     int64_t *n2, int *scale ) {
+  if ( d1.scale_ >= d2.scale_ ) {
+    *n1 = d1.small_;
+    *scale = d1.scale_;
+    return fixed_mul( d2.small_, power_of_10[ d1.scale_ - d2.scale_ ], n2 );
+  }
+  *n2 = d2.small_;
+  *scale = d2.scale_;
+  return fixed_mul( d1.small_, power_of_10[ d2.scale_ - d1.scale_ ], n1 );
+}
+
+void Decimal::set( value_type const &v ) {
+  if ( v.sign() ) {
+    int const digits = v.significant_digits();
+    int const exponent = v.exponent();
+    int const scale = digits - 1 - exponent > 0 ? digits - 1 - exponent : 0;
+    if ( scale <= max_scale && digits <= max_scale && exponent < max_scale ) {
+      char buf[ 64 ];
+      v.toFixPtString( buf, scale );
+      int64_t n = 0;
+      char const *p = buf + (*buf == '-');
+      for ( ; ascii::is_digit( *p ); ++p )
+        n = n * 10 + (*p - '0');
+      if ( *p == '.' )
+        ++p;
+      for ( int i = 0; i < scale; ++i )
+        n = n * 10 + (ascii::is_digit( *p ) ? *p++ - '0' : 0);
+      set_fixed( *buf == '-' ? -n : n, scale );
+      return;
+    }
+    if ( big_ )
+      *big_ = v;
+    else
+      big_ = new value_type( v );
+  } else
+    set_fixed( 0, 0 );
+}
+
+void Decimal::set_fixed( int64_t n, int scale ) {
+  while ( scale && n % 10 == 0 ) {
+    n /= 10;
+    --scale;
+  }
+  if ( n <= -power_of_10[ max_scale ] || n >= power_of_10[ max_scale ] ) {
+    //
+    // Like set(), keep values of more than max_scale digits in MAPM form so
+    // that every value has a single representation.
+    //
+    char buf[ 2 * max_scale + 4 ];
+    value_type const v( fixed_format( n, scale, buf ) );
+    if ( big_ )
+      *big_ = v;
+    else
+      big_ = new value_type( v );
+    return;
+  }
+  delete big_;
+  big_ = nullptr;
+  small_ = n;
+  scale_ = scale;
+}
+
+void Decimal::set_int( long long n ) {
+  if ( n >= -fixed_max )
+    set_fixed( n, 0 );
+  else {
+    ascii::itoa_buf_type buf;
+    set( value_type( ascii::itoa( n, buf ) ) );
+  }
+}
+
+void Decimal::set_uint( unsigned long long n ) {
+  if ( n <= static_cast<unsigned long long>( fixed_max ) )
+    set_fixed( static_cast<int64_t>( n ), 0 );
+  else {
+    ascii::itoa_buf_type buf;
+    set( value_type( ascii::itoa( n, buf ) ) );
+  }
+}
+
+/**
+ * Gets the integer part of a fixed-point value.
+ *
+ * @return Returns \c false if this value is not in fixed-point form.
+ */
+bool Decimal::fixed_trunc( int64_t *result ) const {
+  if ( big_ )
+    return false;
+  *result = small_ / power_of_10[ scale_ ];
+  return true;
+}
+
+/**
+ * Rounds a fixed-point value to the given number of fractional digits,
+ * rounding halves either up or to even.
+ */
+Decimal Decimal::fixed_round( int precision, bool half_to_even ) const {
+  if ( precision >= scale_ )
+    return *this;
+  int64_t const p = power_of_10[ scale_ - precision ];
+  int64_t q = small_ / p, r = small_ % p;
+  if ( r < 0 ) {
+    --q;
+    r += p;
+  }
+  if ( 2 * r > p || (2 * r == p && (!half_to_even || q % 2)) )
+    ++q;
+  return fixed( q, precision );
+}
+
+template<class T>
+bool Decimal::fixed_precision( IntegerImpl<T> const &precision, int *result ) {
+#ifdef ZORBA_WITH_BIG_INTEGER
+  if ( precision.sign() )
+    return false;
+  *result = 0;
+  return true;
+#else
+  if ( precision.value_ < 0 || precision.value_ > max_scale )
+    return false;
+  *result = static_cast<int>( precision.value_ );
+  return true;
+#endif /* ZORBA_WITH_BIG_INTEGER */
+}
+
+Decimal::value_type Decimal::value() const {
+  if ( big_ )
+    return *big_;
+  char buf[ 2 * max_scale + 4 ];
+  return value_type( fixed_format( small_, scale_, buf ) );
+}
+
 ////////// constructors ///////////////////////////////////////////////////////
 
-Decimal::Decimal( long long n ) {
-  ascii::itoa_buf_type buf;
-  value_ = ascii::itoa( n, buf );
+Decimal::Decimal( long n ) : big_( nullptr ) {
+  set_int( n );
+}
+
+Decimal::Decimal( long long n ) : big_( nullptr ) {
+  set_int( n );
 }
 
-Decimal::Decimal( unsigned long n ) {
-  ascii::itoa_buf_type buf;
-  value_ = ascii::itoa( n, buf );
+Decimal::Decimal( unsigned long n ) : big_( nullptr ) {
+  set_uint( n );
 }
 
-Decimal::Decimal( unsigned long long n ) {
-  ascii::itoa_buf_type buf;
-  value_ = ascii::itoa( n, buf );
+Decimal::Decimal( unsigned long long n ) : big_( nullptr ) {
+  set_uint( n );
 }
 
-Decimal::Decimal( float f ) {
+Decimal::Decimal( float f ) : big_( nullptr ) {
   if ( f != f ||
        f ==  std::numeric_limits<float>::infinity() ||
        f == -std::numeric_limits<float>::infinity() )
     throw invalid_argument( "float value = infinity" );
-  value_ = f;
+  set( value_type( f ) );
 }
 
-Decimal::Decimal( double d ) {
+Decimal::Decimal( double d ) : big_( nullptr ) {
   if ( d != d ||
        d ==  std::numeric_limits<double>::infinity() ||
        d == -std::numeric_limits<double>::infinity() )
     throw invalid_argument( "double value = infinity" );
-  value_ = d;
+  set( value_type( d ) );
 }
 
-Decimal::Decimal( Double const &d ) {
+Decimal::Decimal( Double const &d ) : big_( nullptr ) {
   if ( !d.isFinite() )
     throw invalid_argument( "double value = infinity" );
-  value_ = d.getNumber();
+  set( value_type( d.getNumber() ) );
 }
 
-Decimal::Decimal( Float const &f ) {
+Decimal::Decimal( Float const &f ) : big_( nullptr ) {
   if ( !f.isFinite() )
     throw invalid_argument( "float value = infinity" );
-  value_ = f.getNumber();
+  set( value_type( f.getNumber() ) );
 }
 
 template<class T>
-Decimal::Decimal( IntegerImpl<T> const &i ) : value_( i.itod() ) {
+Decimal::Decimal( IntegerImpl<T> const &i ) : big_( nullptr ) {
+#ifdef ZORBA_WITH_BIG_INTEGER
+  set( i.itod() );
+#else
+  set_int( i.value_ );
+#endif /* ZORBA_WITH_BIG_INTEGER */
 }
 
 // instantiate Decimal-from-Integer constructors
@@ -204,20 +501,22 @@ template Decimal::Decimal( PositiveInteger const& );
 ////////// assignment operators ///////////////////////////////////////////////
 
 Decimal& Decimal::operator=( long long n ) {
-  ascii::itoa_buf_type buf;
-  value_ = ascii::itoa( n, buf );
+  set_int( n );
   return *this;
 }
 
 Decimal& Decimal::operator=( unsigned long long n ) {
-  ascii::itoa_buf_type buf;
-  value_ = ascii::itoa( n, buf );
+  set_uint( n );
   return *this;
 }
 
 template<class T>
 Decimal& Decimal::operator=( IntegerImpl<T> const &i ) {
-  value_ = i.itod();
+#ifdef ZORBA_WITH_BIG_INTEGER
+  set( i.itod() );
+#else
+  set_int( i.value_ );
+#endif /* ZORBA_WITH_BIG_INTEGER */
   return *this;
 }
 
@@ -230,26 +529,89 @@ template Decimal& Decimal::operator=( PositiveInteger const& );
 Decimal& Decimal::operator=( Double const &d ) {
   if ( !d.isFinite() )
     throw invalid_argument( "not finite" );
-  value_ = d.getNumber();
+  set( value_type( d.getNumber() ) );
   return *this;
 }
 
 Decimal& Decimal::operator=( Float const &f ) {
   if ( !f.isFinite() )
     throw invalid_argument( "not finite" );
-  value_ = f.getNumber();
+  set( value_type( f.getNumber() ) );
   return *this;
 }
 
 ////////// arithmetic operators ///////////////////////////////////////////////
 
+Decimal operator+( Decimal const &d1, Decimal const &d2 ) {
+  int64_t n1, n2, sum;
+  int scale;
+  if ( !d1.big_ && !d2.big_ && Decimal::align( d1, d2, &n1, &n2, &scale ) &&
+       fixed_add( n1, n2, &sum ) )
+    return Decimal::fixed( sum, scale );
+  return d1.value() + d2.value();
+}
+
+Decimal operator-( Decimal const &d1, Decimal const &d2 ) {
+  int64_t n1, n2, diff;
+  int scale;
+  if ( !d1.big_ && !d2.big_ && Decimal::align( d1, d2, &n1, &n2, &scale ) &&
+       fixed_add( n1, -n2, &diff ) )
+    return Decimal::fixed( diff, scale );
+  return d1.value() - d2.value();
+}
+
+Decimal operator*( Decimal const &d1, Decimal const &d2 ) {
+  int64_t product;
+  if ( !d1.big_ && !d2.big_ && d1.scale_ + d2.scale_ <= Decimal::max_scale &&
+       fixed_mul( d1.small_, d2.small_, &product ) )
+    return Decimal::fixed( product, d1.scale_ + d2.scale_ );
+  return d1.value() * d2.value();
+}
+
+Decimal operator/( Decimal const &d1, Decimal const &d2 ) {
+  int64_t n1, n2;
+  int scale;
+  if ( !d1.big_ && !d2.big_ && d2.small_ &&
+       Decimal::align( d1, d2, &n1, &n2, &scale ) ) {
+    //
+    // The scales cancel out, so n1 / n2 is the quotient.  It's computed only
+    // if it has a fixed-point form; otherwise MAPM determines its precision.
+    //
+    for ( int s = 0; s <= Decimal::max_scale; ++s ) {
+      if ( n1 % n2 == 0 )
+        return Decimal::fixed( n1 / n2, s );
+      if ( !fixed_mul( n1, 10, &n1 ) )
+        break;
+    }
+  }
+  return d1.value() / d2.value();
+}
+
+Decimal operator%( Decimal const &d1, Decimal const &d2 ) {
+  int64_t n1, n2;
+  int scale;
+  if ( !d1.big_ && !d2.big_ && d2.small_ &&
+       Decimal::align( d1, d2, &n1, &n2, &scale ) )
+    return Decimal::fixed( n1 % n2, scale );
+  return d1.value() % d2.value();
+}
+
+Decimal Decimal::operator-() const {
+  if ( big_ )
+    return -*big_;
+  Decimal result;
+  result.small_ = -small_;
+  result.scale_ = scale_;
+  return result;
+}
+
 #define ZORBA_INSTANTIATE(OP,I) \
   template Decimal operator OP( Decimal const&, I const& )
 
 #define ZORBA_DECIMAL_OP(OP)                                          \
   template<class T> inline                                            \
   Decimal operator OP( Decimal const &d, IntegerImpl<T> const &i ) {  \
-    return d.value_ OP i.itod();                                      \
+    return d OP Decimal( i );                                         \
   }                                                                   \
   ZORBA_INSTANTIATE(OP,Integer);                                      \
   ZORBA_INSTANTIATE(OP,NegativeInteger);                              \
@@ -273,7 +635,7 @@ ZORBA_DECIMAL_OP(%);
 #define ZORBA_DECIMAL_OP(OP)                                      \
   template<class T> inline                                        \
   bool operator OP( Decimal const &d, IntegerImpl<T> const &i ) { \
-    return d.value_ OP i.itod();                                  \
+    return d OP Decimal( i );                                     \
   }                                                               \
   ZORBA_INSTANTIATE( OP, Integer );                               \
   ZORBA_INSTANTIATE( OP, NegativeInteger );                       \
@@ -292,13 +654,42 @@ ZORBA_DECIMAL_OP(>=);
 
 ////////// math functions /////////////////////////////////////////////////////
 
+int Decimal::compare( Decimal const &d ) const {
+  if ( !big_ && !d.big_ ) {
+    if ( scale_ == d.scale_ )
+      return small_ < d.small_ ? -1 : small_ > d.small_;
+    int64_t n1, n2;
+    int scale;
+    if ( align( *this, d, &n1, &n2, &scale ) )
+      return n1 < n2 ? -1 : n1 > n2;
+  }
+  return value().compare( d.value() );
+}
+
+Decimal Decimal::ceil() const {
+  if ( big_ )
+    return big_->ceil();
+  int64_t const p = power_of_10[ scale_ ];
+  return fixed( small_ / p + (small_ % p > 0), 0 );
+}
+
+Decimal Decimal::floor() const {
+  if ( big_ )
+    return big_->floor();
+  int64_t const p = power_of_10[ scale_ ];
+  return fixed( small_ / p - (small_ % p < 0), 0 );
+}
+
 Decimal Decimal::round() const {
   return round( numeric_consts<xs_integer>::zero() );
 }
 
 template<class T>
 Decimal Decimal::round( IntegerImpl<T> const &precision ) const {
-  return round2( value_, precision.itod() );
+  int fixed_prec;
+  if ( !big_ && fixed_precision( precision, &fixed_prec ) )
+    return fixed_round( fixed_prec, false );
+  return round2( value(), precision.itod() );
 }
 
 template Decimal Decimal::round( Integer const& ) const;
@@ -324,7 +715,10 @@ Decimal::value_type Decimal::round2( value_type const &v,
 
 template<class T>
 Decimal Decimal::roundHalfToEven( IntegerImpl<T> const &precision ) const {
-  return roundHalfToEven2( value_, precision.itod() );
+  int fixed_prec;
+  if ( !big_ && fixed_precision( precision, &fixed_prec ) )
+    return fixed_round( fixed_prec, true );
+  return roundHalfToEven2( value(), precision.itod() );
 }
 
 template Decimal Decimal::roundHalfToEven( Integer const& ) const;
@@ -351,10 +745,37 @@ Decimal::value_type Decimal::roundHalfToEven2( value_type const &v,
   return result;
 }
 
+Decimal Decimal::sqrt() const {
+  return value().sqrt();
+}
+
 ////////// miscellaneous //////////////////////////////////////////////////////
 
 size_t Decimal::alloc_size() const {
-  return value_.significant_digits();
+  return big_ ? big_->significant_digits() : 0;
+}
+
+bool Decimal::is_xs_int() const {
+  if ( !big_ )
+    return !scale_ &&
+           small_ >= numeric_limits<int32_t>::min() &&
+           small_ <= numeric_limits<int32_t>::max();
+  return big_->is_integer() &&
+         *big_ >= MAPM::getMinInt32() && *big_ <= MAPM::getMaxInt32();
+}
+
+bool Decimal::is_xs_long() const {
+  if ( !big_ )
+    return !scale_;
+  return big_->is_integer() &&
+         *big_ >= MAPM::getMinInt64() && *big_ <= MAPM::getMaxInt64();
+}
+
+uint32_t Decimal::hash() const {
+  if ( big_ )
+    return hash( *big_ );
+  // same as hash(value_type): the integer part's low 32 bits
+  return static_cast<uint32_t>( (small_ / power_of_10[ scale_ ]) & 0xFFFFFFFF );
 }
 
 uint32_t Decimal::hash( value_type const &value ) {
@@ -397,6 +818,15 @@ uint32_t Decimal::hash( value_type const &value ) {
   return static_cast<uint32_t>( n );
 }
 
+zstring Decimal::toString( int precision ) const {
+  if ( !big_ && scale_ <= precision &&
+       precision >= ZORBA_FLOAT_POINT_PRECISION ) {
+    char buf[ 2 * max_scale + 4 ];
+    return fixed_format( small_, scale_, buf );
+  }
+  return toString( value(), precision );
+}
+
 zstring Decimal::toString( value_type const &value, bool minusZero,
                            int precision ) {
   char buf[ 2048 ];
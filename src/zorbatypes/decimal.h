@@ -108,6 +108,8 @@ public:
    */
   Decimal( Decimal const &d );
 
+  ~Decimal();
+
   ////////// assignment operators /////////////////////////////////////////////
 
   /**
@@ -236,12 +238,49 @@ public:
 
 private:
   typedef MAPM value_type;
-  typedef long int_cast_type;
 
-  value_type value_;
+  /**
+   * The maximum number of fractional digits of a fixed-point value; it's also
+   * the maximum number of digits of its unscaled value so that the latter
+   * always fits in an \c int64_t.
+   */
+  static int const max_scale = 18;
+
+  //
+  // A value that can be written with at most max_scale digits (not counting
+  // leading zeros) and at most max_scale fractional digits is kept in
+  // fixed-point form: its value is small_ * 10^-scale_ and big_ is null.  The
+  // fixed-point form is canonical: scale_ is the minimal one, i.e., small_
+  // has no trailing fractional zeros.  Any other value is kept in *big_.
+  //
+  // Both set() and set_fixed() apply this rule, so every value that fits the
+  // fixed-point form is kept that way and a fixed-point value never equals a
+  // MAPM one.
+  //
+  int64_t small_;
+  int scale_;
+  value_type *big_;
+
   static value_type const round_precision_limit;
 
-  Decimal( value_type const &v ) : value_( v ) { }
+  Decimal( value_type const &v ) : big_( nullptr ) { set( v ); }
+
+  static Decimal fixed( int64_t n, int scale );
+
+  static bool align( Decimal const&, Decimal const&, int64_t*, int64_t*,
+                     int *scale );
+
+  void set( value_type const& );
+  void set_fixed( int64_t n, int scale );
+  void set_int( long long );
+  void set_uint( unsigned long long );
+
+  bool fixed_trunc( int64_t *result ) const;
+  Decimal fixed_round( int precision, bool half_to_even ) const;
+  value_type value() const;
+
+  template<class T>
+  static bool fixed_precision( IntegerImpl<T> const&, int *result );
 
   static uint32_t hash( value_type const& );
 
@@ -250,6 +289,9 @@ private:
     parse_decimal
   };
 
+  static bool parse_fixed( char const *s, int64_t *result, int *scale );
+  void parse( char const *s );
+
   static void parse( char const *s, value_type *result,
                      int parse_options = parse_decimal );
 
@@ -278,43 +320,57 @@ private:
 ////////// constructors ///////////////////////////////////////////////////////
 
 #define ZORBA_DECIMAL_CTOR(T) \
-  inline Decimal::Decimal( T n ) : value_( static_cast<int_cast_type>( n ) ) { }
+  inline Decimal::Decimal( T n ) : small_( n ), scale_( 0 ), big_( nullptr ) { }
 
 ZORBA_DECIMAL_CTOR(char)
 ZORBA_DECIMAL_CTOR(signed char)
 ZORBA_DECIMAL_CTOR(short)
 ZORBA_DECIMAL_CTOR(int)
-ZORBA_DECIMAL_CTOR(long)
 ZORBA_DECIMAL_CTOR(unsigned char)
 ZORBA_DECIMAL_CTOR(unsigned short)
 ZORBA_DECIMAL_CTOR(unsigned int)
 #undef ZORBA_DECIMAL_CTOR
 
-inline Decimal::Decimal( char const *s ) {
-  parse( s, &value_ );
+inline Decimal::Decimal( char const *s ) : big_( nullptr ) {
+  parse( s );
 }
 
 template<class StringType>
 inline Decimal::Decimal( StringType const &s,
-  typename std::enable_if<ZORBA_HAS_C_STR(StringType)>::type* )
+  typename std::enable_if<ZORBA_HAS_C_STR(StringType)>::type* ) :
+  big_( nullptr )
 {
-  parse( s.c_str(), &value_ );
+  parse( s.c_str() );
 }
 
-inline Decimal::Decimal( Decimal const &d ) : value_( d.value_ )
+inline Decimal::Decimal( Decimal const &d ) :
+  small_( d.small_ ),
+  scale_( d.scale_ ),
+  big_( d.big_ ? new value_type( *d.big_ ) : nullptr )
 {
 }
 
+inline Decimal::~Decimal() {
+  delete big_;
+}
+
 ////////// assignment operators ///////////////////////////////////////////////
 
 inline Decimal& Decimal::operator=( Decimal const &d ) {
-  value_ = d.value_;
+  if ( d.big_ )
+    set( *d.big_ );
+  else {
+    delete big_;
+    big_ = nullptr;
+    small_ = d.small_;
+    scale_ = d.scale_;
+  }
   return *this;
 }
 
 #define ZORBA_DECIMAL_OP(T)                   \
   inline Decimal& Decimal::operator=( T n ) { \
-    value_ = static_cast<int_cast_type>( n ); \
+    set_int( n );                             \
     return *this;                             \
   }
 
@@ -326,11 +382,15 @@ ZORBA_DECIMAL_OP(long)
 ZORBA_DECIMAL_OP(unsigned char)
 ZORBA_DECIMAL_OP(unsigned short)
 ZORBA_DECIMAL_OP(unsigned int)
-ZORBA_DECIMAL_OP(unsigned long)
 #undef ZORBA_DECIMAL_OP
 
+inline Decimal& Decimal::operator=( unsigned long n ) {
+  set_uint( n );
+  return *this;
+}
+
 inline Decimal& Decimal::operator=( char const *s ) {
-  parse( s, &value_ );
+  parse( s );
   return *this;
 }
 
@@ -344,9 +404,9 @@ Decimal::operator=( StringType const &s ) {
 
 ////////// arithmetic operators ///////////////////////////////////////////////
 
-#define ZORBA_DECIMAL_OP(OP)                                            \
-  inline Decimal operator OP( Decimal const &d1, Decimal const &d2 ) {  \
-    return d1.value_ OP d2.value_;                                      \
+#define ZORBA_DECIMAL_OP(OP)                                  \
+  inline Decimal& Decimal::operator OP##=( Decimal const &d ) { \
+    return *this = *this OP d;                                \
   }
 
 ZORBA_DECIMAL_OP(+)
@@ -356,99 +416,49 @@ ZORBA_DECIMAL_OP(/)
 ZORBA_DECIMAL_OP(%)
 #undef ZORBA_DECIMAL_OP
 
-#define ZORBA_DECIMAL_OP(OP)                                  \
-  inline Decimal& Decimal::operator OP( Decimal const &d ) {  \
-    value_ OP d.value_;                                       \
-    return *this;                                             \
-  }
-
-ZORBA_DECIMAL_OP(+=)
-ZORBA_DECIMAL_OP(-=)
-ZORBA_DECIMAL_OP(*=)
-ZORBA_DECIMAL_OP(/=)
-ZORBA_DECIMAL_OP(%=)
-#undef ZORBA_DECIMAL_OP
-
-inline Decimal Decimal::operator-() const {
-  return -value_;
-}
-
 ////////// relational operators ///////////////////////////////////////////////
 
 inline bool operator==( Decimal const &d1, Decimal const &d2 ) {
-  return d1.value_ == d2.value_;
+  if ( d1.big_ && d2.big_ )
+    return *d1.big_ == *d2.big_;
+  return !d1.big_ && !d2.big_ &&
+         d1.small_ == d2.small_ && d1.scale_ == d2.scale_;
 }
 
 inline bool operator!=( Decimal const &d1, Decimal const &d2 ) {
-  return d1.value_ != d2.value_;
+  return !(d1 == d2);
 }
 
 inline bool operator<( Decimal const &d1, Decimal const &d2 ) {
-  return d1.value_ < d2.value_;
+  return d1.compare( d2 ) < 0;
 }
 
 inline bool operator<=( Decimal const &d1, Decimal const &d2 ) {
-  return d1.value_ <= d2.value_;
+  return d1.compare( d2 ) <= 0;
 }
 
 inline bool operator>( Decimal const &d1, Decimal const &d2 ) {
-  return d1.value_ > d2.value_;
+  return d1.compare( d2 ) > 0;
 }
 
 inline bool operator>=( Decimal const &d1, Decimal const &d2 ) {
-  return d1.value_ >= d2.value_;
-}
-
-////////// math functions /////////////////////////////////////////////////////
-
-inline Decimal Decimal::ceil() const {
-  return value_.ceil();
-}
-
-inline Decimal Decimal::floor() const {
-  return value_.floor();
-}
-
-inline Decimal Decimal::sqrt() const {
-  return value_.sqrt();
+  return d1.compare( d2 ) >= 0;
 }
 
 ////////// miscellaneous //////////////////////////////////////////////////////
 
-inline int Decimal::compare( Decimal const &d ) const {
-  return value_.compare( d.value_ );
-}
-
-inline uint32_t Decimal::hash() const {
-  return hash( value_ );
-}
-
-inline bool Decimal::is_xs_int() const {
-  return value_.is_integer() &&
-         value_ >= MAPM::getMinInt32() && value_ <= MAPM::getMaxInt32();
-}
-
 inline bool Decimal::is_xs_integer() const {
-  return value_.is_integer() != 0;
-}
-
-inline bool Decimal::is_xs_long() const {
-  return value_.is_integer() &&
-         value_ >= MAPM::getMinInt64() && value_ <= MAPM::getMaxInt64();
+  return big_ ? big_->is_integer() != 0 : !scale_;
 }
 
 inline int Decimal::sign() const {
-  return value_.sign();
+  return big_ ? big_->sign() : (small_ > 0) - (small_ < 0);
 }
 
 inline Decimal::operator internal::ztd::explicit_bool::type() const {
   return explicit_bool::value_of( sign() );
 }
 
-inline zstring Decimal::toString( int precision ) const {
-  return toString( value_, precision );
-}
-
 inline std::ostream& operator<<( std::ostream &os, Decimal const &d ) {
   return os << d.toString();
 }
@@ -16,6 +16,8 @@
 
 #include "stdafx.h"
 
+#include <cfloat>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <stdlib.h>
@@ -51,6 +53,193 @@ zstring const& neg_inf_str() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/**
+ * Rounds a string of decimal digits, with the first digit scaled by
+ * 10^*exponent, half away from zero to at most \a max_digits digits, and then
+ * removes its trailing zeros.  Since \a digits never begins with a zero, a
+ * carry out of the first digit yields "1" and increments \a *exponent.
+ */
+static void round_digits( char *digits, int *n, int *exponent,
+                          int max_digits ) {
+  if ( *n > max_digits ) {
+    bool const round_up = digits[ max_digits ] >= '5';
+    *n = max_digits;
+    if ( round_up ) {
+      int i = max_digits - 1;
+      while ( i >= 0 && digits[i] == '9' )
+        digits[ i-- ] = '0';
+      if ( i >= 0 )
+        ++digits[i];
+      else {
+        digits[0] = '1';
+        *n = 1;
+        ++*exponent;
+      }
+    }
+  }
+  while ( *n > 1 && digits[ *n - 1 ] == '0' )
+    --*n;
+}
+
+/**
+ * Formats a non-zero value in fixed-point notation exactly like
+ * Decimal::toString( MAPM( v ).round( precision ), false, places ) does, but
+ * without going through MAPM: MAPM(double) takes the 17 significant digits
+ * printed by "%.16E", MAPM::round() keeps precision + 1 of them, and
+ * toFixPtString() rounds the result to \a places fractional digits.
+ */
+static void fixpt_to_string( double v, int precision, int places, char *buf ) {
+  char sci[32];
+  sprintf( sci, "%.16E", v );
+  char const *s = sci;
+  bool const negative = *s == '-';
+  if ( negative )
+    ++s;
+
+  char digits[24];
+  int n = 0;
+  digits[ n++ ] = *s++;
+  if ( *s == '.' )
+    while ( ascii::is_digit( *++s ) )
+      digits[ n++ ] = *s;
+  int exponent = atoi( s + 1 );
+
+  round_digits( digits, &n, &exponent, precision + 1 );
+
+  int const keep = exponent + places + 1;
+  if ( keep > 0 )
+    round_digits( digits, &n, &exponent, keep );
+  else if ( keep == 0 && digits[0] >= '5' ) {
+    digits[0] = '1';
+    n = 1;
+    ++exponent;
+  } else {
+    ::strcpy( buf, "0" );
+    return;
+  }
+
+  char *p = buf;
+  if ( negative )
+    *p++ = '-';
+  if ( exponent < 0 ) {
+    *p++ = '0';
+    *p++ = '.';
+    for ( int i = exponent + 1; i < 0; ++i )
+      *p++ = '0';
+    ::memcpy( p, digits, n );
+    p += n;
+  } else {
+    for ( int i = 0; i <= exponent; ++i )
+      *p++ = i < n ? digits[i] : '0';
+    if ( n > exponent + 1 ) {
+      *p++ = '.';
+      ::memcpy( p, digits + exponent + 1, n - exponent - 1 );
+      p += n - exponent - 1;
+    }
+  }
+  *p = '\0';
+}
+
+/**
+ * The limits within which a decimal literal with a mantissa of at most
+ * max_digits digits and a power-of-ten exponent of at most max_exponent in
+ * absolute value can be converted with a single, hence correctly rounded,
+ * floating-point multiplication or division: both the mantissa and the power
+ * of ten are exactly representable.
+ */
+template<typename F>
+struct exact_parse_traits;
+
+template<>
+struct exact_parse_traits<double> {
+  static int const max_digits = 15;
+  static int const max_exponent = 22;
+};
+
+template<>
+struct exact_parse_traits<float> {
+  static int const max_digits = 7;
+  static int const max_exponent = 10;
+};
+
+static double const exact_power_of_10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * Parses a floating-point literal without calling strtod(3) when that can be
+ * done exactly.
+ *
+ * @param s The literal.  It must not begin with whitespace.
+ * @param result The parsed value.
+ * @return Returns \c false if \a s is not a well-formed literal within the
+ * limits of exact_parse_traits, in which case it's left to strtod(3).
+ */
+template<typename F>
+static bool exact_parse( char const *s, F *result ) {
+#if FLT_EVAL_METHOD == 0
+  typedef exact_parse_traits<F> traits;
+
+  bool const negative = *s == '-';
+  if ( *s == '+' || *s == '-' )
+    ++s;
+
+  unsigned long long mantissa = 0;
+  int digits = 0, exponent = 0;
+  bool got_digit = false;
+  for ( ; ascii::is_digit( *s ); ++s ) {
+    got_digit = true;
+    if ( (mantissa || *s != '0') && ++digits > traits::max_digits )
+      return false;
+    mantissa = mantissa * 10 + (*s - '0');
+  }
+  if ( *s == '.' ) {
+    for ( ++s; ascii::is_digit( *s ); ++s ) {
+      got_digit = true;
+      if ( (mantissa || *s != '0') && ++digits > traits::max_digits )
+        return false;
+      mantissa = mantissa * 10 + (*s - '0');
+      --exponent;
+    }
+  }
+  if ( !got_digit )
+    return false;
+  if ( *s == 'e' || *s == 'E' ) {
+    ++s;
+    bool const negative_exponent = *s == '-';
+    if ( *s == '+' || *s == '-' )
+      ++s;
+    if ( !ascii::is_digit( *s ) )
+      return false;
+    int e = 0;
+    for ( ; ascii::is_digit( *s ); ++s )
+      if ( (e = e * 10 + (*s - '0')) > 2 * traits::max_exponent )
+        return false;
+    exponent += negative_exponent ? -e : e;
+  }
+  if ( *ascii::trim_start_space( s ) )
+    return false;
+
+  if ( !mantissa ) {
+    *result = negative ? -F(0) : F(0);
+    return true;
+  }
+  if ( exponent < -traits::max_exponent || exponent > traits::max_exponent )
+    return false;
+
+  F value = static_cast<F>( mantissa );
+  if ( exponent < 0 )
+    value /= static_cast<F>( exact_power_of_10[ -exponent ] );
+  else
+    value *= static_cast<F>( exact_power_of_10[ exponent ] );
+  *result = negative ? -value : value;
+  return true;
+#else
+  return false;
+#endif /* FLT_EVAL_METHOD */
+}
+
 static void count_significant_digits( char digit, int *significant_digits,
                                       int *trailing_zeros ) {
   if ( digit == '0' )
@@ -112,7 +301,8 @@ void FloatImpl<F>::parse( char const *s ) {
       throw std::invalid_argument(
         BUILD_STRING( '"', first_non_ws, "\": invalid floating-point literal" )
       );
-    value_ = ztd::aton<value_type>( first_non_ws );
+    if ( !exact_parse( first_non_ws, &value_ ) )
+      value_ = ztd::aton<value_type>( first_non_ws );
   }
 
   precision_ = significant_digits < max_precision() ?
@@ -355,9 +545,11 @@ zstring FloatImpl<F>::toString( bool no_scientific_format ) const {
 #if 1
     // This is the "spec" implementation, i.e., it is an exact application of
     // the spec in  http://www.w3.org/TR/xpath-functions/#casting
-    MAPM temp( value_ );
-    temp = temp.round( precision_ );
-    return Decimal::toString( temp, isNegZero(), max_precision() );
+    char buf[ 2048 ];
+    fixpt_to_string( value_, precision_, max_precision(), buf );
+    if ( max_precision() < ZORBA_FLOAT_POINT_PRECISION )
+      Decimal::reduce( buf );
+    return buf;
 #else
     std::stringstream stream;
     stream.precision(7);
@@ -40,6 +40,10 @@ FTToken::Stemmer::~Stemmer() {
   // out-of-line because it's virtual
 }
 
+void const* FTToken::Stemmer::identity() const {
+  return this;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 FTToken::FTToken( char const *utf8_s, int len,
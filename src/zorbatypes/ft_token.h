@@ -68,6 +68,15 @@ public:
      */
     virtual void operator()( string_t const &word, locale::iso639_1::type lang,
                              string_t *result ) const = 0;
+
+    /**
+     * Gets a value identifying how this stemmer stems: stemmers having the
+     * same identity stem every word the same way.  By default, it's the
+     * stemmer itself.
+     *
+     * @return Returns said identity.
+     */
+    virtual void const* identity() const;
   };
 
   /////////////////////////////////////////////////////////////////////////////
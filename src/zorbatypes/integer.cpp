@@ -110,7 +110,14 @@ IntegerImpl<T>::IntegerImpl( unsigned long long n ) {
 
 template<class T>
 IntegerImpl<T>::IntegerImpl( Decimal const &d ) {
-  value_ = T::check_value( ftoi( d.value_ ) );
+#ifndef ZORBA_WITH_BIG_INTEGER
+  int64_t n;
+  if ( d.fixed_trunc( &n ) ) {
+    value_ = T::check_value( n );
+    return;
+  }
+#endif /* ZORBA_WITH_BIG_INTEGER */
+  value_ = T::check_value( ftoi( d.value() ) );
 }
 
 template<class T>
@@ -157,7 +164,14 @@ IntegerImpl<T>& IntegerImpl<T>::operator=( unsigned long long n ) {
 
 template<class T>
 IntegerImpl<T>& IntegerImpl<T>::operator=( Decimal const &d ) {
-  value_ = T::check_value( ftoi( d.value_ ) );
+#ifndef ZORBA_WITH_BIG_INTEGER
+  int64_t n;
+  if ( d.fixed_trunc( &n ) ) {
+    value_ = T::check_value( n );
+    return *this;
+  }
+#endif /* ZORBA_WITH_BIG_INTEGER */
+  value_ = T::check_value( ftoi( d.value() ) );
   return *this;
 }
 
@@ -185,7 +199,7 @@ IntegerImpl<T>& IntegerImpl<T>::operator=( Float const &f ) {
 #define ZORBA_INTEGER_OP(OP)                                          \
   template<class T>                                                   \
   Decimal operator OP( IntegerImpl<T> const &i, Decimal const &d ) {  \
-    return i.itod() OP d.value_;                                      \
+    return Decimal( i ) OP d;                                         \
   }                                                                   \
   ZORBA_INSTANTIATE( OP, Integer );                                   \
   ZORBA_INSTANTIATE( OP, NegativeInteger );                           \
@@ -313,7 +327,7 @@ ZORBA_INTEGER_OP(unsigned long long)
 
 template<class T>
 bool operator==( IntegerImpl<T> const &i, Decimal const &d ) {
-  return d.is_xs_integer() && i.itod() == d.value_;
+  return d.is_xs_integer() && Decimal( i ) == d;
 }
 
 ZORBA_INSTANTIATE( ==, Integer );
@@ -325,7 +339,7 @@ ZORBA_INSTANTIATE( ==, PositiveInteger );
 #define ZORBA_INTEGER_OP(OP)                                      \
   template<class T>                                               \
   bool operator OP( IntegerImpl<T> const &i, Decimal const &d ) { \
-    return i.itod() OP d.value_;                                  \
+    return Decimal( i ) OP d;                                     \
   }                                                               \
   ZORBA_INSTANTIATE( OP, Integer );                               \
   ZORBA_INSTANTIATE( OP, NegativeInteger );                       \
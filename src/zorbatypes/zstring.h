@@ -18,6 +18,7 @@
 #define ZSTRING_H
 
 #include "util/atomic_int.h"
+#include "util/plain_int.h"
 #include "util/string/buf_rep.h"
 #include "util/string/default_rep.h"
 #include "util/string/ptr_rep.h"
@@ -26,8 +27,16 @@
 
 namespace zorba {
 
-typedef rstring_classes::rep<atomic_int> default_rep;
-typedef rstring_classes::ptr_rep<atomic_int> ptr_rep;
+#ifdef ZORBA_FOR_ONE_THREAD_ONLY
+// Strings are never shared between threads, so their reference counts need
+// not be updated atomically.
+typedef plain_int zstring_count;
+#else
+typedef atomic_int zstring_count;
+#endif
+
+typedef rstring_classes::rep<zstring_count> default_rep;
+typedef rstring_classes::ptr_rep<zstring_count> ptr_rep;
 typedef rstring_classes::buf_rep<default_rep> buf_rep;
 
 typedef rstring< default_rep > zstring;
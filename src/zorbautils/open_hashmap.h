@@ -0,0 +1,675 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ZORBA_UTILS_OPEN_HASHMAP_H
+#define ZORBA_UTILS_OPEN_HASHMAP_H
+
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <zorba/config.h>
+
+#include "common/common.h"
+
+#include "zorbautils/fatal.h"
+#include "zorbautils/mutex.h"
+
+#include "store/api/shared_types.h"
+
+
+namespace zorba
+{
+
+/*******************************************************************************
+
+  This template class implements a hash-based map from items of type K to items
+  of type V, using open addressing with linear probing and Robin Hood
+  insertion. It offers the same interface as the HashMap class (except for the
+  load factor, which is fixed) and is meant for maps that are probed often and
+  whose iteration order does not matter.
+
+  C is the template parameter that implements the hashing and equality
+  functions. It must have the same two methods as for HashMap:
+    uint32_t hash(const K&);
+    bool equal(const K&, const K&);
+
+  theSlots     : The hash table. Each slot stores a key, its value, its hash
+                 code, and the distance (plus 1) of the slot from the home slot
+                 of the key; a distance of 0 marks a free slot. The key/value
+                 pairs are stored inline, so a probe touches consecutive memory,
+                 and the equality function is called only on keys whose hash
+                 code matches. Probe sequences never wrap around: the table has
+                 theCapacity home slots followed by some overflow slots, and
+                 more overflow slots are appended if a probe sequence would go
+                 past its end. As a result, erasing an entry only moves entries
+                 that come after it in the table.
+
+  theCapacity  : The number of home slots; always a power of 2.
+
+  theShift     : 32 - log2(theCapacity). The home slot of a key is given by the
+                 high bits of its hash code multiplied by the golden ratio.
+
+  theNumEntries: The total number of mappings stored in the map.
+
+  theMaxLoad   : The number of entries after which the table is doubled.
+
+********************************************************************************/
+template <class K, class V, class C>
+class OpenHashMap
+{
+  OpenHashMap( OpenHashMap const& );
+  OpenHashMap& operator=( OpenHashMap const& );
+
+  struct Slot
+  {
+    K         theKey;
+    V         theValue;
+    uint32_t  theHash;
+    uint32_t  theDist;
+
+    Slot() : theKey(), theValue(), theHash(0), theDist(0) {}
+  };
+
+  typedef std::vector<Slot> slot_tab_type;
+
+public:
+  typedef K key_type;
+  typedef V value_type;
+  typedef C key_equal;
+
+  static const csize MIN_CAPACITY = 8;
+
+  class iterator
+  {
+    friend class OpenHashMap;
+
+  protected:
+    slot_tab_type                 * theSlots;
+    csize                           thePos;
+
+  protected:
+    iterator(slot_tab_type* slots, csize pos)
+      :
+      theSlots(slots),
+      thePos(pos)
+    {
+      skipFree();
+    }
+
+    void skipFree()
+    {
+      while (thePos < theSlots->size() && (*theSlots)[thePos].theDist == 0)
+        thePos++;
+    }
+
+  public:
+    iterator() : theSlots(NULL), thePos(-1) {}
+
+    bool operator==(const iterator& other) const
+    {
+      return theSlots == other.theSlots && thePos == other.thePos;
+    }
+
+    bool operator!=(const iterator& it) const
+    {
+      return theSlots != it.theSlots || thePos != it.thePos;
+    }
+
+    iterator& operator++()
+    {
+      if (thePos < theSlots->size())
+      {
+        thePos++;
+        skipFree();
+      }
+      return *this;
+    }
+
+    std::pair<K, V> operator*() const
+    {
+      ZORBA_FATAL(thePos < theSlots->size(), "");
+
+      const Slot& slot = (*theSlots)[thePos];
+
+      return std::pair<K, V>(slot.theKey, slot.theValue);
+    }
+
+    const K& getKey() const
+    {
+      ZORBA_FATAL(thePos < theSlots->size(), "");
+
+      return (*theSlots)[thePos].theKey;
+    }
+
+    const V& getValue() const
+    {
+      ZORBA_FATAL(thePos < theSlots->size(), "");
+
+      return (*theSlots)[thePos].theValue;
+    }
+
+    V& getValue()
+    {
+      ZORBA_FATAL(thePos < theSlots->size(), "");
+
+      return (*theSlots)[thePos].theValue;
+    }
+
+    void setValue(const V& val)
+    {
+      ZORBA_FATAL(thePos < theSlots->size(), "");
+
+      (*theSlots)[thePos].theValue = val;
+    }
+  };
+
+protected:
+  slot_tab_type                  theSlots;
+
+  csize                          theCapacity;
+
+  unsigned int                   theShift;
+
+  csize                          theNumEntries;
+
+  csize                          theMaxLoad;
+
+  C                              theCompareFunction;
+
+  SYNC_CODE(mutable Mutex        theMutex;)
+  SYNC_CODE(Mutex              * theMutexp;)
+
+public:
+
+/***************************************************************************//**
+  Constructor: Allocates a hash table that can hold the given number of entries
+  without growing. This constructor takes as input a comparison-function obj,
+  for comparison functions whose hash() and equal() methods are not static.
+********************************************************************************/
+OpenHashMap(const C& compFunction, csize size, bool sync)
+  :
+  theNumEntries(0),
+  theCompareFunction(compFunction)
+{
+  allocate(size);
+
+  SYNC_CODE(theMutexp = (sync ? &theMutex : NULL);)
+}
+
+
+/***************************************************************************//**
+  Constructor: Allocates a hash table that can hold the given number of entries
+  without growing. It should be used when the C::hash() and C::equal() methods
+  are static.
+********************************************************************************/
+OpenHashMap(csize size, bool sync)
+  :
+  theNumEntries(0)
+{
+  allocate(size);
+
+  SYNC_CODE(theMutexp = (sync ? &theMutex : NULL);)
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+virtual ~OpenHashMap()
+{
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+SYNC_CODE(                 \
+Mutex* get_mutex() const   \
+{                          \
+  return theMutexp;        \
+}                          \
+)
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool empty() const
+{
+  return (theNumEntries == 0);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+csize size() const
+{
+  return theNumEntries;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+csize capacity() const
+{
+  return theSlots.size();
+}
+
+
+/*******************************************************************************
+  Return the number of bytes used by the hash table.
+********************************************************************************/
+csize memory_size() const
+{
+  return sizeof(*this) + theSlots.capacity() * sizeof(Slot);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+C get_compare_function()
+{
+  return theCompareFunction;
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+void clear()
+{
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  if (theNumEntries == 0)
+    return;
+
+  theNumEntries = 0;
+
+  for (typename slot_tab_type::iterator ite = theSlots.begin();
+       ite != theSlots.end();
+       ++ite)
+  {
+    if (ite->theDist != 0)
+      *ite = Slot();
+  }
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+iterator begin() const
+{
+  return iterator(const_cast<slot_tab_type*>(&theSlots), 0);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+iterator end() const
+{
+  return iterator(const_cast<slot_tab_type*>(&theSlots), theSlots.size());
+}
+
+
+/*******************************************************************************
+  Return true if the map already contains an item that is "equal" to the given
+  item; otherwise return false.
+********************************************************************************/
+bool exists(const K& item) const
+{
+  uint32_t hval = hash(item);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  return lookup(item, hval) < theSlots.size();
+}
+
+
+/*******************************************************************************
+  If the given item is already in the map, return an iterator positioned at the
+  associated entry; otherwise return the end iterator.
+********************************************************************************/
+iterator find(const K& item)
+{
+  uint32_t hval = hash(item);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  return iterator(&theSlots, lookup(item, hval));
+}
+
+
+/*******************************************************************************
+  If the given item is already in the map, return true and a copy of the value
+  associated with the item; otherwise return false.
+********************************************************************************/
+bool get(const K& item, V& value) const
+{
+  uint32_t hval = hash(item);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  csize pos = lookup(item, hval);
+
+  if (pos == theSlots.size())
+    return false;
+
+  value = theSlots[pos].theValue;
+  return true;
+}
+
+
+/******************************************************************************
+  If the map does not already contain an item I that is "equal" to the given
+  item, make a copy of the given item and its associated value and place the
+  new (item, value) pair in the map; then return true. Otherwise, return false.
+********************************************************************************/
+bool insert(const std::pair<const K, V>& pair)
+{
+  uint32_t hval = hash(pair.first);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  if (lookup(pair.first, hval) < theSlots.size())
+    return false;
+
+  place(pair.first, pair.second, hval);
+  return true;
+}
+
+
+/******************************************************************************
+  If the map does not already contain an item I that is "equal" to the given
+  item, make a copy of the given item and its associated value and place the
+  new (item, value) pair in the map; then return true. Otherwise, return false,
+  as well as a copy of the value associated with the found item I.
+********************************************************************************/
+bool insert(const K& item, V& value)
+{
+  uint32_t hval = hash(item);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  csize pos = lookup(item, hval);
+
+  if (pos < theSlots.size())
+  {
+    value = theSlots[pos].theValue;
+    return false;
+  }
+
+  place(item, value, hval);
+  return true;
+}
+
+
+/******************************************************************************
+  If the map does not already contain an item I that is "equal" to the given
+  item, return false. Otherwise, set the value associated with I to the given
+  value and return true,
+********************************************************************************/
+bool update(const K& item, const V& value)
+{
+  uint32_t hval = hash(item);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  csize pos = lookup(item, hval);
+
+  if (pos == theSlots.size())
+    return false;
+
+  theSlots[pos].theValue = value;
+  return true;
+}
+
+
+/*******************************************************************************
+  Remove the item that is pointed to by the given iterator and move the iterator
+  to the next item.
+********************************************************************************/
+void erase(iterator& ite)
+{
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  ZORBA_FATAL(ite.thePos < theSlots.size(), "");
+
+  eraseSlot(ite.thePos);
+
+  // The entries following the erased one have been shifted back by one slot,
+  // so the next item, if any, is at or after the current position.
+  ite.skipFree();
+}
+
+
+/*******************************************************************************
+  If the map contains an item that is "equal" to the given item, remove that
+  item from the map and return true. Otherwise, return false.
+********************************************************************************/
+bool erase(const K& item)
+{
+  uint32_t hval = hash(item);
+
+  SYNC_CODE(AutoMutex lock(theMutexp);)
+
+  csize pos = lookup(item, hval);
+
+  if (pos == theSlots.size())
+    return false;
+
+  eraseSlot(pos);
+  return true;
+}
+
+
+protected:
+
+/*******************************************************************************
+
+********************************************************************************/
+uint32_t hash(const K& item) const
+{
+  return theCompareFunction.hash(item);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+bool equal(const K& item1, const K& item2) const
+{
+  return theCompareFunction.equal(item1, item2);
+}
+
+
+/*******************************************************************************
+
+********************************************************************************/
+csize home(uint32_t hval) const
+{
+  return static_cast<uint32_t>(hval * 2654435769u) >> theShift;
+}
+
+
+/*******************************************************************************
+  Allocate an empty table with enough home slots for the given number of
+  entries.
+********************************************************************************/
+void allocate(csize numEntries)
+{
+  csize capacity = MIN_CAPACITY;
+
+  // Keep the load below 7/8.
+  while (capacity - capacity / 8 < numEntries)
+    capacity *= 2;
+
+  allocateCapacity(capacity);
+}
+
+
+/*******************************************************************************
+  Allocate an empty table with the given number of home slots (a power of 2),
+  plus 2 * log2(capacity) overflow slots.
+********************************************************************************/
+void allocateCapacity(csize capacity)
+{
+  theCapacity = capacity;
+  theShift = 32;
+
+  for (csize c = capacity; c > 1; c /= 2)
+    --theShift;
+
+  theMaxLoad = theCapacity - theCapacity / 8;
+
+  slot_tab_type slots(theCapacity + (32 - theShift) * 2);
+  theSlots.swap(slots);
+}
+
+
+/*******************************************************************************
+  Return the position of the slot holding the given item, or theSlots.size()
+  if the item is not in the map. Because of the Robin Hood invariant, the
+  search stops at the first slot whose entry is closer to its home slot than
+  the item would be.
+********************************************************************************/
+csize lookup(const K& item, uint32_t hval) const
+{
+  csize numSlots = theSlots.size();
+  csize pos = home(hval);
+  uint32_t dist = 1;
+
+  for (; pos < numSlots; ++pos, ++dist)
+  {
+    const Slot& slot = theSlots[pos];
+
+    if (slot.theDist < dist)
+      break;
+
+    if (slot.theHash == hval && equal(slot.theKey, item))
+      return pos;
+  }
+
+  return numSlots;
+}
+
+
+/*******************************************************************************
+  Add the given (item, value) pair, which is known not to be in the map,
+  growing the table if needed.
+********************************************************************************/
+void place(const K& item, const V& value, uint32_t hval)
+{
+  if (theNumEntries >= theMaxLoad)
+    grow();
+
+  Slot entry;
+  entry.theKey = item;
+  entry.theValue = value;
+  entry.theHash = hval;
+
+  placeSlot(entry);
+
+  ++theNumEntries;
+}
+
+
+/*******************************************************************************
+  Insert the given entry, displacing the entries that are closer to their home
+  slot than the entry being placed. The displaced entries move forward to the
+  first free slot after the home slot of the given entry; if there is no such
+  slot, more overflow slots are appended first. On return, "entry" is free.
+********************************************************************************/
+void placeSlot(Slot& entry)
+{
+  csize pos = home(entry.theHash);
+
+  csize last = pos;
+  while (last < theSlots.size() && theSlots[last].theDist != 0)
+    ++last;
+
+  if (last == theSlots.size())
+    theSlots.resize(last + (32 - theShift) * 2);
+
+  for (entry.theDist = 1; pos < last; ++pos, ++entry.theDist)
+  {
+    Slot& slot = theSlots[pos];
+
+    if (slot.theDist < entry.theDist)
+      std::swap(slot, entry);
+  }
+
+  std::swap(theSlots[last], entry);
+}
+
+
+/*******************************************************************************
+  Remove the entry at the given position, shifting back the entries that follow
+  it in the same probe sequences.
+********************************************************************************/
+void eraseSlot(csize pos)
+{
+  csize numSlots = theSlots.size();
+  csize next = pos + 1;
+
+  for (; next < numSlots && theSlots[next].theDist > 1; ++pos, ++next)
+  {
+    std::swap(theSlots[pos], theSlots[next]);
+    --theSlots[pos].theDist;
+  }
+
+  theSlots[pos] = Slot();
+  --theNumEntries;
+}
+
+
+/*******************************************************************************
+  Double the number of home slots and rehash every entry.
+********************************************************************************/
+void grow()
+{
+  slot_tab_type oldSlots;
+  oldSlots.swap(theSlots);
+
+  allocateCapacity(theCapacity * 2);
+
+  for (typename slot_tab_type::iterator ite = oldSlots.begin();
+       ite != oldSlots.end();
+       ++ite)
+  {
+    if (ite->theDist != 0)
+      placeSlot(*ite);
+  }
+}
+
+};
+
+
+} // namespace zorba
+
+#endif
+
+/*
+ * Local variables:
+ * mode: c++
+ * End:
+ */
+/* vim:set et sw=2 ts=2: */
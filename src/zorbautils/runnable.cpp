@@ -296,8 +296,11 @@ zorba::Runnable::finishImpl()
 #endif
 
   // the last thing to do is to signal a possible join waiting
-  // for this Runnable to terminate
+  // for this Runnable to terminate. The finish mutex is held by join until it
+  // waits on the condition, so the signal cannot get lost.
+  theFinishMutex.lock();
   theFinishCondition.signal();
+  theFinishMutex.unlock();
 
   theMutex.unlock();
 }
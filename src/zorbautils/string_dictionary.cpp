@@ -0,0 +1,90 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "stdafx.h"
+
+#include "zorbautils/string_dictionary.h"
+
+#include "util/string_util.h"
+
+
+namespace zorba
+{
+
+const csize StringDictionary::DEFAULT_MAX_ENTRIES = 4096;
+
+const csize StringDictionary::DEFAULT_MAX_LENGTH = 64;
+
+
+/*******************************************************************************
+
+********************************************************************************/
+StringDictionary::StringDictionary(csize maxEntries, csize maxLength)
+  :
+  HashSet<zstring, StringDictionaryCompareFunction>(256, false),
+  theMaxEntries(maxEntries),
+  theMaxLength(maxLength)
+{
+}
+
+
+/*******************************************************************************
+  Return in outStr the string of the dictionary that is equal to the given
+  string, adding a copy of the given string to the dictionary if it is not
+  already there and the dictionary is not full. If the string is too long or
+  the dictionary is full, return a private copy of the given string.
+********************************************************************************/
+void StringDictionary::intern(const char* str, csize len, zstring& outStr)
+{
+  if (len > theMaxLength)
+  {
+    outStr.assign(str, len);
+    return;
+  }
+
+  HashEntry<zstring, DummyHashValue>* entry =
+  bucket(hashfun::h32(str, len, FNV_32_INIT));
+
+  if (!entry->isFree())
+  {
+    for (; entry != NULL; entry = entry->getNext())
+    {
+      if (ztd::equals(entry->key(), str, len))
+      {
+        outStr = entry->key();
+        return;
+      }
+    }
+  }
+
+  outStr.assign(str, len);
+
+  if (theNumEntries < theMaxEntries)
+    insert(outStr);
+}
+
+
+/*******************************************************************************
+  Release the dictionary's references to its strings.
+********************************************************************************/
+void StringDictionary::clear()
+{
+  if (theNumEntries > 0)
+    HashSet<zstring, StringDictionaryCompareFunction>::clear();
+}
+
+
+} // namespace zorba
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#ifndef ZORBA_UTILS_STRING_DICTIONARY
+#define ZORBA_UTILS_STRING_DICTIONARY
+
+#include "common/common.h"
+#include "zorbatypes/zstring.h"
+
+#include "zorbautils/hashset.h"
+#include "zorbautils/hashfun.h"
+
+
+namespace zorba
+{
+
+
+class StringDictionaryCompareFunction
+{
+public:
+  static bool equal(const zstring& s1, const zstring& s2)
+  {
+    return s1 == s2;
+  }
+
+  static uint32_t hash(const zstring& s)
+  {
+    return hashfun::h32(s.data(), s.size(), FNV_32_INIT);
+  }
+};
+
+
+/*******************************************************************************
+  A bounded, non-synchronized set of zstrings used by the loaders to make the
+  repeated text and attribute values of the data they load share a single
+  string representation.
+
+  Only strings of at most theMaxLength bytes are interned, and no new strings
+  are added once the dictionary holds theMaxEntries of them; the strings that
+  are not interned are simply copied. The dictionary keeps a reference to each
+  string in it, so it should be cleared when the load it serves is done.
+********************************************************************************/
+class StringDictionary : protected HashSet<zstring, StringDictionaryCompareFunction>
+{
+public:
+  static const csize DEFAULT_MAX_ENTRIES;
+  static const csize DEFAULT_MAX_LENGTH;
+
+protected:
+  csize  theMaxEntries;
+  csize  theMaxLength;
+
+public:
+  StringDictionary(
+      csize maxEntries = DEFAULT_MAX_ENTRIES,
+      csize maxLength = DEFAULT_MAX_LENGTH);
+
+  void intern(const char* str, csize len, zstring& outStr);
+
+  void clear();
+
+  csize size() const
+  {
+    return HashSet<zstring, StringDictionaryCompareFunction>::size();
+  }
+};
+
+
+} // namespace zorba
+
+#endif
+
+/*
+ * Local variables:
+ * mode: c++
+ * End:
+ */
+/* vim:set et sw=2 ts=2: */
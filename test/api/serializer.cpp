@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <sstream>
 #include <string.h>
 
 #include <zorba/zorba.h>
@@ -62,6 +63,200 @@ test_serialization_error(Zorba* aZorba)
 }
 
 
+static std::string
+serialize_query(
+    Zorba* aZorba,
+    const char* aQuery,
+    const char* aMethod,
+    const char* aThreads)
+{
+  XQuery_t lQuery = aZorba->compileQuery(aQuery);
+
+  Zorba_SerializerOptions_t lOptions;
+  lOptions.set("method", aMethod);
+  lOptions.set("parallel-threads", aThreads);
+  Serializer_t lSerializer = Serializer::createSerializer(lOptions);
+
+  std::ostringstream lResult;
+  lSerializer->serialize(lQuery->iterator(), lResult);
+  return lResult.str();
+}
+
+
+// parallel serialization must produce the same bytes as sequential
+bool
+test_parallel_serialization(Zorba* aZorba)
+{
+  const char* lQueries[][2] =
+  {
+    { "for $i in 1 to 1000 return { \"id\" : $i, \"v\" : [ $i, \"x\" ] }",
+      "json" },
+    { "for $i in 1 to 1000 return ($i, <a id='{$i}'>{$i}</a>, $i, $i)",
+      "xml" },
+    { "for $i in 1 to 1000 return ($i, <a>{$i}</a>, { \"a\" : $i })",
+      "json-xml-hybrid" },
+    { "for $i in 1 to 1000 return (<a>{$i}</a>, $i, $i)",
+      "text" }
+  };
+
+  for (size_t i = 0; i < sizeof(lQueries) / sizeof(lQueries[0]); ++i)
+  {
+    std::string lSequential =
+      serialize_query(aZorba, lQueries[i][0], lQueries[i][1], "0");
+    std::string lParallel =
+      serialize_query(aZorba, lQueries[i][0], lQueries[i][1], "4");
+
+    if (lSequential != lParallel)
+    {
+      std::cerr << "parallel " << lQueries[i][1] << " serialization differs: "
+                << lParallel << std::endl;
+      return false;
+    }
+  }
+
+  // the number of threads a query or caller may ask for is bounded
+  try {
+    serialize_query(aZorba, lQueries[0][0], lQueries[0][1], "100000");
+    std::cerr << "parallel-threads=100000 was accepted" << std::endl;
+    return false;
+  }
+  catch (ZorbaException const&) {
+  }
+  return true;
+}
+
+
+// a sequence must serialize the same after a binary-xdm round trip
+bool
+test_binary_xdm(Zorba* aZorba)
+{
+  const char* lQuery =
+    "declare namespace p = 'urn:p';"
+    "(1, -7, xs:int(-3), xs:unsignedByte(200), 1.5e3, xs:float(0.25),"
+    " 2.5, true(), 'str', xs:untypedAtomic('u'), xs:anyURI('http://a'),"
+    " xs:date('2013-01-01'), xs:QName('p:q'), null,"
+    " document { <p:a x='1' p:y='2'>t<!--c--><?pi v?><b/>{ 42 }</p:a> },"
+    " <a xmlns='urn:d'><b>{ 1 to 3 }</b></a>,"
+    " { \"k\" : [ 1, \"two\", { \"k\" : null } ], \"l\" : true },"
+    " [ ], { })";
+
+  XQuery_t lQuery1 = aZorba->compileQuery(lQuery);
+  XQuery_t lQuery2 = aZorba->compileQuery(lQuery);
+
+  Zorba_SerializerOptions_t lOptions;
+  lOptions.set("method", "json-xml-hybrid");
+  Serializer_t lSerializer = Serializer::createSerializer(lOptions);
+
+  Zorba_SerializerOptions_t lBinaryOptions;
+  lBinaryOptions.set("method", "binary-xdm");
+  Serializer_t lBinarySerializer = Serializer::createSerializer(lBinaryOptions);
+
+  std::ostringstream lExpected;
+  lSerializer->serialize(lQuery1->iterator(), lExpected);
+
+  std::stringstream lEncoded;
+  lBinarySerializer->serialize(lQuery2->iterator(), lEncoded);
+
+  ItemSequence_t lDecoded = Serializer::parseBinaryXDM(lEncoded);
+  std::ostringstream lResult;
+  lSerializer->serialize(lDecoded.get(), lResult);
+
+  if (lExpected.str() != lResult.str())
+  {
+    std::cerr << "binary-xdm round trip differs: " << lResult.str()
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+
+// a binary-xdm stream that nests elements too deeply must raise an error
+// instead of overflowing the stack
+bool
+test_binary_xdm_depth()
+{
+  std::string lData("ZXDM\x01", 5);
+
+  // <a> with a new qname ("", "", "a"), no bindings and no attributes
+  lData += std::string("\x04\x00\x00\x00\x00\x00\x00\x01" "a" "\x00\x00", 11);
+  for (int i = 0; i < 100000; ++i)
+    lData += std::string("\x04\x01\x00\x00", 4);
+
+  std::istringstream lStream(lData);
+  ItemSequence_t lDecoded = Serializer::parseBinaryXDM(lStream);
+
+  Zorba_SerializerOptions_t lOptions;
+  Serializer_t lSerializer = Serializer::createSerializer(lOptions);
+
+  try {
+    std::ostringstream lResult;
+    lSerializer->serialize(lDecoded.get(), lResult);
+    std::cerr << "deeply nested binary-xdm stream was accepted" << std::endl;
+    return false;
+  }
+  catch (ZorbaException const&) {
+  }
+  return true;
+}
+
+
+// a query that constructs aDepth nested arrays (the node ids of the store
+// limit the depth of nodes to less than that)
+static std::string
+nested_arrays(int aDepth)
+{
+  std::string lQuery;
+  for (int i = 0; i < aDepth; ++i)
+    lQuery += "[";
+  for (int i = 0; i < aDepth; ++i)
+    lQuery += "]";
+  return lQuery;
+}
+
+
+// the binary-xdm emitter must reject the items that nest too deeply for the
+// loader, and accept the ones that nest just deep enough
+bool
+test_binary_xdm_emit_depth(Zorba* aZorba)
+{
+  Zorba_SerializerOptions_t lOptions;
+  lOptions.set("method", "binary-xdm");
+  Serializer_t lSerializer = Serializer::createSerializer(lOptions);
+
+  Zorba_SerializerOptions_t lXmlOptions;
+  Serializer_t lXmlSerializer = Serializer::createSerializer(lXmlOptions);
+
+  try {
+    XQuery_t lQuery = aZorba->compileQuery(nested_arrays(1024));
+
+    std::stringstream lEncoded;
+    lSerializer->serialize(lQuery->iterator(), lEncoded);
+
+    ItemSequence_t lDecoded = Serializer::parseBinaryXDM(lEncoded);
+    std::ostringstream lResult;
+    lXmlSerializer->serialize(lDecoded.get(), lResult);
+  }
+  catch (ZorbaException const& e) {
+    std::cerr << "1024 nested arrays were rejected: " << e << std::endl;
+    return false;
+  }
+
+  XQuery_t lQuery = aZorba->compileQuery(nested_arrays(1025));
+
+  try {
+    std::ostringstream lTooDeep;
+    lSerializer->serialize(lQuery->iterator(), lTooDeep);
+    std::cerr << "1025 nested arrays were emitted as binary-xdm"
+              << std::endl;
+    return false;
+  }
+  catch (ZorbaException const&) {
+  }
+  return true;
+}
+
+
 int
 serializer(int argc, char* argv[]) 
 {
@@ -71,6 +266,22 @@ serializer(int argc, char* argv[])
     return 1;
   }
 
+  if (!test_parallel_serialization(lZorba)) {
+    return 2;
+  }
+
+  if (!test_binary_xdm(lZorba)) {
+    return 3;
+  }
+
+  if (!test_binary_xdm_depth()) {
+    return 4;
+  }
+
+  if (!test_binary_xdm_emit_depth(lZorba)) {
+    return 5;
+  }
+
   return 0;
 }
 
@@ -0,0 +1 @@
+1 2 3 1 2 3 0.5 1 1.5 true false true 1 2.5 true false 2000-01-01 1999-12-31 P1D 1 2 1.5 2.25 7 8 5 3 bc 3 12 err:FORG0001
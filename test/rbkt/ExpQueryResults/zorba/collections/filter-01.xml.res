@@ -0,0 +1 @@
+a b e 1 2 5 6 4
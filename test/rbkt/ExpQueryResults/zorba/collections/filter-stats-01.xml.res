@@ -0,0 +1 @@
+7 7 name equality 2 40 2 true
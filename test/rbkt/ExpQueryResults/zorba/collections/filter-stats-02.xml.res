@@ -0,0 +1 @@
+7 {http://www.example.com/p}name equality 1 20 1
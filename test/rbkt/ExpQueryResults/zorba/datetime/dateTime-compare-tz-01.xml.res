@@ -0,0 +1 @@
+true true true 2000-01-01T00:00:00.123457Z 2000-01-01T00:00:00.05Z 1
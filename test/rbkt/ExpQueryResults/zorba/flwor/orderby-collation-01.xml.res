@@ -0,0 +1 @@
+[] [Apple] [apple] [banana] [cherry] [date] [eclair] [Éclair] B b á A a
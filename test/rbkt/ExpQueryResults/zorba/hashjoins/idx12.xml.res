@@ -0,0 +1 @@
+<r>1 2</r><r>2 3</r>
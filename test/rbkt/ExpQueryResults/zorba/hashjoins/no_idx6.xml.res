@@ -0,0 +1 @@
+1 3 5 1 3 5 7 9 11 13 15 17 19
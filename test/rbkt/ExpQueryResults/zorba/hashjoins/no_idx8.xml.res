@@ -0,0 +1 @@
+2002 3003 4004 5005 6006 7007 8008 9009 10010 11011 12012 13013 14014 15015 16016 17017 18018 19019 20020 21021 22022 23023 24024 25025 26026 27027 28028 29029 30030 31031 32032 33033 34034 35035 36036 37037 38038 39039 40040 41041 42042 43043 44044 45045 46046 47047 48048 49049 50050 51051 52052 53053 54054 55055 56056 57057 58058 59059 60060 61061 62062 63063 64064 65065 66066 67067 68068 69069 70070 71071 72072 73073 74074 75075 76076 77077 78078 79079 80080 81081 82082 83083 84084 85085 86086 87087 88088 89089 90090 91091 92092 93093 94094 95095 96096 97097 98098 99099 100100
\ No newline at end of file
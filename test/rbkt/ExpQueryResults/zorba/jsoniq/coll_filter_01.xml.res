@@ -0,0 +1 @@
+1 5 5
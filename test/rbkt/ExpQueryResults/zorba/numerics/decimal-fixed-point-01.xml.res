@@ -0,0 +1 @@
+0.3 1000000000000000000 1.03125 0.333333333333333333 5.25 -1.25 -2 2 1.23 -4 -3 0.5 9223372036854775808 true true
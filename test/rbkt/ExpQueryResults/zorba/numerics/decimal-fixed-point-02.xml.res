@@ -0,0 +1 @@
+true true true true 1 1 2 2
@@ -0,0 +1 @@
+0.3 0.3333333333333333 123456.789 0.000001 1.0E6 -2.5E-7 0.3 12.5 0.1428571428571429 -0 3.4028235E38
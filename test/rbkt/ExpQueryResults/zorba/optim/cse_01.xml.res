@@ -0,0 +1 @@
+1:30:2 3:20:2 2:10:2 | true false
@@ -0,0 +1 @@
+fragment text fragment text fragment text
@@ -0,0 +1,2 @@
+<?xml version="1.0" encoding="UTF-8"?>
+3000 1 1025 3000
\ No newline at end of file
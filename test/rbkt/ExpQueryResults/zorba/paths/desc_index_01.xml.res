@@ -0,0 +1 @@
+5 5 5 | 1 2 6 3 4 | 1 2 6 | 2 | 3 0 | 1
@@ -0,0 +1 @@
+1 1 1 | true true true | 5 5 5 | false false false | 3 3 3 | 5 5 5
@@ -0,0 +1 @@
+1 2 3 4 6 | 1 2 3 4 6 | 5 | 2 3 | 6 | b a b b c b x b | 1 2 3 4 6
@@ -0,0 +1 @@
+3 on off true 2 maybe,yes,no,yes yes,yes,no,yes
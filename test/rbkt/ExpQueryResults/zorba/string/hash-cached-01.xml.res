@@ -0,0 +1 @@
+x y z 3 x y z w
@@ -0,0 +1 @@
+4 true false true false false ab [] cd [] abcd 4
@@ -0,0 +1 @@
+66537 true true false true false 65534 97 98 233 1001 éc [] [] 66537 66537 true 65534
@@ -0,0 +1 @@
+añb|ç é d ; e|fé#añb,ç é d|e,fé#añb|ç é d ; e|fé#añb,ç | d ; e,f|
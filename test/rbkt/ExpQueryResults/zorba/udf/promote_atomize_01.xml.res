@@ -0,0 +1 @@
+[x] [] [] [] 3.5 11 XPTY0004
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <zorba/zorba.h>
+#include <zorba/store_manager.h>
+#include <zorba/zorba_exception.h>
+
+using namespace zorba;
+
+static const char* const theProlog =
+  "import module namespace ddl = "
+  "\"http://zorba.io/modules/store/dynamic/collections/ddl\";\n"
+  "import module namespace dml = "
+  "\"http://zorba.io/modules/store/dynamic/collections/dml\";\n";
+
+
+/*
+  Creates the collection with the given name and inserts "size" elements into
+  it, with the ids 1 to size.
+*/
+static void
+create_collection(Zorba* aZorba, const char* aName, int aSize)
+{
+  std::ostringstream q;
+  q << theProlog
+    << "ddl:create(xs:QName(\"" << aName << "\"), "
+    << "for $i in 1 to " << aSize << " return <item id=\"{$i}\"/>)";
+
+  XQuery_t lQuery = aZorba->compileQuery(q.str());
+  lQuery->execute();
+}
+
+
+/*
+  Compiles a join of the range 1 to 10 with the given collection and returns
+  whether the plan joins them through a temp index (hashjoin).
+*/
+static bool
+uses_hashjoin(Zorba* aZorba, const char* aName)
+{
+  std::ostringstream q;
+  q << theProlog
+    << "for $x in 1 to 10\n"
+    << "for $y in dml:collection(xs:QName(\"" << aName << "\"))\n"
+    << "where $x eq xs:integer($y/@id)\n"
+    << "return $y";
+
+  XQuery_t lQuery = aZorba->compileQuery(q.str());
+
+  std::ostringstream lPlan;
+  lQuery->printPlan(lPlan);
+
+  return lPlan.str().find("CreateInternalIndexIterator") != std::string::npos;
+}
+
+
+int
+hashjoin_cost(int argc, char* argv[])
+{
+  void* lStore = StoreManager::getStore();
+  Zorba* lZorba = Zorba::getInstance(lStore);
+  int lResult = 0;
+
+  try
+  {
+    // The size of the collection is not known while it does not exist.
+    if (!uses_hashjoin(lZorba, "small"))
+    {
+      std::cerr << "no hashjoin over a collection that does not exist"
+                << std::endl;
+      lResult = 1;
+    }
+
+    create_collection(lZorba, "small", 3);
+    create_collection(lZorba, "big", 1000);
+
+    // 10 * 3 comparisons are cheaper than building the index.
+    if (uses_hashjoin(lZorba, "small"))
+    {
+      std::cerr << "hashjoin over a collection of 3 items" << std::endl;
+      lResult = 2;
+    }
+
+    // 10 * 1000 comparisons are not.
+    if (!uses_hashjoin(lZorba, "big"))
+    {
+      std::cerr << "no hashjoin over a collection of 1000 items" << std::endl;
+      lResult = 3;
+    }
+  }
+  catch (ZorbaException const& e)
+  {
+    std::cerr << e << std::endl;
+    lResult = 4;
+  }
+
+  lZorba->shutdown();
+  StoreManager::shutdownStore(lStore);
+  return lResult;
+}
+/* vim:set et sw=2 ts=2: */
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2006-2016 zorba.io
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iostream>
+#include <sstream>
+
+#include <zorba/item_factory.h>
+#include <zorba/store_manager.h>
+#include <zorba/zorba.h>
+#include <zorba/zorba_exception.h>
+
+using namespace zorba;
+
+
+// The store interns namespace URIs, prefixes and local names in a string
+// pool, and checks on shutdown that none of them is still in use. Strings of
+// one character must be released like any other, or the shutdown aborts.
+int
+string_pool(int argc, char* argv[])
+{
+  void* lStore = StoreManager::getStore();
+  Zorba* lZorba = Zorba::getInstance(lStore);
+  int lResult = 0;
+
+  try
+  {
+    {
+      XQuery_t lQuery = lZorba->compileQuery(
+        "declare namespace p = \"u\";\n"
+        "<p:a xmlns:q=\"v\" q:b=\"c\">{\n"
+        "  for $c in (\"d\", \"e\", \"f\")\n"
+        "  return element { QName($c, concat(\"q:\", $c)) } { $c }\n"
+        "}</p:a>");
+
+      std::ostringstream lOut;
+      lQuery->execute(lOut);
+      std::cout << lOut.str() << std::endl;
+
+      ItemFactory* lFactory = lZorba->getItemFactory();
+      Item lParent;
+      Item lName = lFactory->createQName("w", "x", "y");
+      Item lType = lFactory->createQName(
+        "http://www.w3.org/2001/XMLSchema", "xs", "untyped");
+      Item lElem = lFactory->createElementNode(lParent, lName, lType,
+                                               false, false, NsBindings());
+      if (lElem.isNull())
+        lResult = 1;
+    }
+  }
+  catch (ZorbaException const& e)
+  {
+    std::cerr << e << std::endl;
+    lResult = 2;
+  }
+
+  lZorba->shutdown();
+  StoreManager::shutdownStore(lStore);
+  return lResult;
+}
+/* vim:set et sw=2 ts=2: */